@@ -36,15 +36,47 @@
 #include "driver/i2c_master.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "esp_rom_sys.h"
 #include "esp_err.h"
 
  /* CERT-C Compliant Constants */
 #define ADS1115_I2C_TIMEOUT_MS          (1000U)    /**< I2C operation timeout */
-#define ADS1115_CONVERSION_DELAY_MS     (10U)      /**< Single-shot conversion delay */
+#define ADS1115_CONVERSION_DELAY_MS     (10U)      /**< Legacy fixed conversion delay (superseded by data-rate derived wait) */
+#define ADS1115_CONVERSION_MARGIN_PCT   (10U)      /**< Oscillator tolerance added to the conversion wait */
+#define ADS1115_OS_POLL_MIN_US          (50U)      /**< Minimum OS bit polling interval */
+#define ADS1115_OS_POLL_MAX_COUNT       (16U)      /**< Maximum OS bit polls before timing out */
+#define ADS1115_RDY_LO_THRESH           (0x0000U)  /**< Lo_thresh value enabling conversion-ready mode */
+#define ADS1115_RDY_HI_THRESH           (0x8000U)  /**< Hi_thresh value enabling conversion-ready mode */
 #define ADS1115_MAX_ADC_VALUE           (32767)    /**< Maximum positive ADC value */
 #define ADS1115_MIN_ADC_VALUE           (-32767)   /**< Maximum negative ADC value */
 #define ADS1115_REGISTER_SIZE_BYTES     (2U)       /**< Register size in bytes */
 
+/**
+ * @brief Nominal conversion period for each data rate
+ *
+ * Indexed by data rate bits 7:5, values in microseconds (1 / SPS rounded
+ * up). Shared by ads1115.c and the compile-time channels in ads1115.hpp.
+ */
+#define ADS1115_DATA_RATE_PERIODS_US { \
+    125000U,        /* 8 SPS */ \
+    62500U,         /* 16 SPS */ \
+    31250U,         /* 32 SPS */ \
+    15625U,         /* 64 SPS */ \
+    7813U,          /* 128 SPS */ \
+    4000U,          /* 250 SPS */ \
+    2106U,          /* 475 SPS */ \
+    1163U           /* 860 SPS */ \
+}
+
+/* Shadow register valid bits (ads1115_handle_t.valid) */
+#define ADS1115_SHADOW_CONFIG           (0x01U)    /**< config_reg matches the device */
+#define ADS1115_SHADOW_LO_THRESH        (0x02U)    /**< lo_thresh matches the device */
+#define ADS1115_SHADOW_HI_THRESH        (0x04U)    /**< hi_thresh matches the device */
+#define ADS1115_SHADOW_POINTER          (0x08U)    /**< pointer matches the device */
+
 /**
  * @brief ADS1115 Register addresses
  */
@@ -178,6 +210,88 @@ typedef struct {
     float voltage_scale;                    /**< Voltage scaling factor (calculated) */
 } ads1115_config_t;
 
+/**
+ * @brief Conversion-ready (ALERT/RDY pin) context
+ *
+ * Holds the GPIO and waiting task used to signal the end of a conversion
+ * from the ALERT/RDY interrupt. Initialize with ads1115_rdy_enable().
+ */
+typedef struct {
+    gpio_num_t alert_io;                    /**< GPIO connected to ALERT/RDY */
+    volatile TaskHandle_t waiting_task;     /**< Task notified by the ISR (internal) */
+    bool enabled;                           /**< True once thresholds and ISR are installed */
+} ads1115_rdy_t;
+
+/**
+ * @brief Scan list entry
+ *
+ * Per-channel settings for ads1115_scan(). Comparator and output format
+ * settings are taken from the base configuration.
+ */
+typedef struct {
+    ads1115_input_mux_t input_mux;          /**< Input multiplexer configuration */
+    ads1115_pga_t pga;                      /**< Programmable gain amplifier setting */
+    ads1115_data_rate_t data_rate;          /**< Data rate (samples per second) */
+} ads1115_scan_entry_t;
+
+/**
+ * @brief Scan result for one scan list entry
+ */
+typedef struct {
+    int16_t raw;                            /**< Raw conversion result */
+    ads1115_pga_t pga;                      /**< PGA used for the conversion */
+    int64_t timestamp_us;                   /**< esp_timer time at conversion start */
+    bool saturated;                         /**< Result clipped at the PGA full scale */
+} ads1115_scan_result_t;
+
+/**
+ * @brief Bus traffic counters
+ *
+ * Byte counts are wire bytes, including the address byte of every
+ * (repeated) start.
+ */
+typedef struct {
+    uint32_t transactions;                  /**< I2C transfers issued */
+    uint32_t bytes;                         /**< Bytes transferred */
+    uint32_t transactions_saved;            /**< Transfers skipped thanks to the shadow registers */
+    uint32_t bytes_saved;                   /**< Bytes skipped thanks to the shadow registers */
+} ads1115_bus_stats_t;
+
+/**
+ * @brief Device handle with shadow registers
+ *
+ * Mirrors the config and threshold registers and the address pointer so
+ * unchanged writes, pointer writes and verification read-backs can be
+ * skipped. Initialize with ads1115_handle_init(). Any bus error clears
+ * all valid bits, forcing the next access to go to the device.
+ */
+typedef struct {
+    i2c_master_dev_handle_t device;         /**< I2C device handle */
+    uint16_t config_reg;                    /**< Shadow config register (OS bit excluded) */
+    uint16_t lo_thresh;                     /**< Shadow Lo_thresh register */
+    uint16_t hi_thresh;                     /**< Shadow Hi_thresh register */
+    uint8_t pointer;                        /**< Shadow address pointer */
+    uint8_t valid;                          /**< ADS1115_SHADOW_* bits */
+    bool verify_writes;                     /**< Read back config writes and compare */
+    ads1115_bus_stats_t stats;              /**< Bus traffic counters */
+} ads1115_handle_t;
+
+/**
+ * @brief Prepared channel descriptor
+ *
+ * Built once by ads1115_prepare() (or at compile time by ads1115.hpp) and
+ * executed many times with ads1115_execute(). All fields are internal and
+ * already serialized for the bus.
+ */
+typedef struct {
+    uint8_t config_write[3];                /**< Pointer byte and config word, MSB first */
+    uint8_t conversion_reg;                 /**< Conversion register pointer byte */
+    bool single_shot;                       /**< Start and wait for a conversion on execute */
+    uint32_t conversion_us;                 /**< Worst-case conversion time */
+    uint32_t poll_us;                       /**< OS bit polling interval */
+    ads1115_pga_t pga;                      /**< PGA setting, for scaling results */
+} ads1115_prepared_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -229,6 +343,8 @@ extern "C" {
      *
      * Initiates a single conversion, waits for completion, and reads the result.
      * This function temporarily overrides the mode setting to single-shot.
+     * The wait is derived from config->data_rate and completion is confirmed
+     * by polling the OS bit, so latency follows the configured rate.
      *
      * @param[in] device_handle Pointer to I2C device handle (must not be NULL)
      * @param[in] config Pointer to configuration structure (must not be NULL)
@@ -236,16 +352,74 @@ extern "C" {
      *
      * @return ESP_OK on success
      * @return ESP_ERR_INVALID_ARG if parameters are NULL
-     * @return ESP_ERR_TIMEOUT if I2C communication times out
+     * @return ESP_ERR_TIMEOUT if I2C communication or the conversion times out
      * @return Other ESP error codes for I2C communication failures
      *
-     * @note This function includes appropriate conversion delay
+     * @note Waits yield the CPU, see ads1115_delay_us()
      * @note Output format depends on config->data_format setting
      */
     esp_err_t ads1115_read_single_shot(i2c_master_dev_handle_t* device_handle,
         const ads1115_config_t* config,
         float* data);
 
+    /**
+     * @brief Check whether a raw result is clipped at full scale
+     *
+     * @param[in] raw Raw conversion result
+     *
+     * @return true if raw is at the positive (ADS1115_MAX_ADC_VALUE) or
+     *         negative (0x8000) full-scale code
+     */
+    bool ads1115_is_saturated(int16_t raw);
+
+    /**
+     * @brief Read one raw ADC result
+     *
+     * Returns the conversion result as signed counts without any float
+     * conversion. In single-shot mode a conversion is started and waited
+     * for; in continuous mode the latest result is read.
+     *
+     * @param[in] device_handle Pointer to I2C device handle (must not be NULL)
+     * @param[in] config Pointer to configuration structure (must not be NULL)
+     * @param[out] raw Pointer to store the raw result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return ESP_ERR_TIMEOUT if I2C communication or the conversion times out
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note config->data_format is ignored
+     */
+    esp_err_t ads1115_read_raw(i2c_master_dev_handle_t* device_handle,
+        const ads1115_config_t* config,
+        int16_t* raw);
+
+    /**
+     * @brief Read a block of raw ADC results
+     *
+     * In single-shot mode, runs count back-to-back conversions. In
+     * continuous mode, sets the address pointer once and reads count
+     * results paced at the worst-case conversion time, so each read is a
+     * bare 2-byte transfer.
+     *
+     * @param[in] device_handle Pointer to I2C device handle (must not be NULL)
+     * @param[in] config Pointer to configuration structure (must not be NULL)
+     * @param[out] samples Output block with count elements (must not be NULL)
+     * @param[in] count Number of samples to read
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return ESP_ERR_TIMEOUT if I2C communication or a conversion times out
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Convert blocks with ads1115_convert_to_volts() or
+     *       ads1115_convert_to_microvolts() outside the acquisition loop
+     */
+    esp_err_t ads1115_read_raw_block(i2c_master_dev_handle_t* device_handle,
+        const ads1115_config_t* config,
+        int16_t* samples,
+        size_t count);
+
     /**
      * @brief Initialize ADS1115 configuration with safe defaults
      *
@@ -261,6 +435,371 @@ extern "C" {
      */
     esp_err_t ads1115_init_default_config(ads1115_config_t* config);
 
+    /**
+     * @brief Get the nominal conversion period for a data rate
+     *
+     * 1 / SPS rounded up, with no oscillator margin. This is the average
+     * spacing of conversions in continuous mode.
+     *
+     * @param[in] data_rate Data rate setting
+     *
+     * @return Period in microseconds
+     */
+    uint32_t ads1115_get_data_rate_period_us(ads1115_data_rate_t data_rate);
+
+    /**
+     * @brief Get the worst-case conversion time for a data rate
+     *
+     * Returns the nominal conversion period for the data rate plus
+     * ADS1115_CONVERSION_MARGIN_PCT to cover internal oscillator tolerance.
+     *
+     * @param[in] data_rate Data rate setting
+     *
+     * @return Conversion time in microseconds
+     */
+    uint32_t ads1115_get_conversion_time_us(ads1115_data_rate_t data_rate);
+
+    /**
+     * @brief Block the calling task for a conversion wait
+     *
+     * Waits of one RTOS tick or more use vTaskDelay() (rounded up to whole
+     * ticks). Shorter waits block on a one-shot esp_timer, so sub-tick
+     * conversion times are neither stretched to a full tick nor spun.
+     *
+     * @param[in] duration_us Wait in microseconds
+     *
+     * @note Must be called from a task, not from an ISR
+     */
+    void ads1115_delay_us(uint32_t duration_us);
+
+    /**
+     * @brief Get the voltage scale factor for a PGA setting
+     *
+     * @param[in] pga PGA setting
+     *
+     * @return Volts per LSB (±2.048V scale for invalid settings)
+     */
+    float ads1115_get_pga_voltage_scale(ads1115_pga_t pga);
+
+    /**
+     * @brief Enable conversion-ready signalling on the ALERT/RDY pin
+     *
+     * Programs the threshold registers for conversion-ready mode
+     * (Lo_thresh MSB = 0, Hi_thresh MSB = 1), configures the GPIO as an
+     * input with pull-up and installs a falling-edge ISR that notifies the
+     * task waiting in ads1115_read_single_shot_rdy().
+     *
+     * @param[in] device_handle Pointer to I2C device handle (must not be NULL)
+     * @param[out] rdy Pointer to conversion-ready context (must not be NULL)
+     * @param[in] alert_io GPIO connected to the ALERT/RDY pin
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL or GPIO is invalid
+     * @return Other ESP error codes for I2C or GPIO failures
+     *
+     * @note The GPIO ISR service is installed if not already present
+     * @note Conversion results must not be used for threshold comparisons
+     *       while conversion-ready mode is active
+     */
+    esp_err_t ads1115_rdy_enable(i2c_master_dev_handle_t* device_handle,
+        ads1115_rdy_t* rdy,
+        gpio_num_t alert_io);
+
+    /**
+     * @brief Disable conversion-ready signalling
+     *
+     * Removes the ALERT/RDY ISR handler and disables the GPIO interrupt.
+     * The threshold registers are left unchanged.
+     *
+     * @param[in,out] rdy Pointer to conversion-ready context (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if rdy is NULL
+     * @return ESP_ERR_INVALID_STATE if conversion-ready mode is not enabled
+     */
+    esp_err_t ads1115_rdy_disable(ads1115_rdy_t* rdy);
+
+    /**
+     * @brief Perform single-shot ADC conversion completed by ALERT/RDY
+     *
+     * Starts a conversion with the comparator fields forced to
+     * conversion-ready signalling and blocks on a task notification from the
+     * ALERT/RDY ISR. If the notification does not arrive within twice the
+     * conversion time, the OS bit is polled instead.
+     *
+     * @param[in] device_handle Pointer to I2C device handle (must not be NULL)
+     * @param[in] config Pointer to configuration structure (must not be NULL)
+     * @param[in] rdy Conversion-ready context, or NULL to poll the OS bit
+     * @param[out] data Pointer to store the result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return ESP_ERR_TIMEOUT if the conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Uses the calling task's notification value (index 0)
+     * @note Output format depends on config->data_format setting
+     */
+    esp_err_t ads1115_read_single_shot_rdy(i2c_master_dev_handle_t* device_handle,
+        const ads1115_config_t* config,
+        ads1115_rdy_t* rdy,
+        float* data);
+
+    /**
+     * @brief Run a scan list as one conversion sequence
+     *
+     * Converts every entry in order in single-shot mode. The next entry's
+     * conversion is started as soon as the current one completes, before
+     * its result is read; the conversion register keeps the result until
+     * the next conversion finishes, so the read overlaps the next
+     * conversion. With ALERT/RDY each completion is taken from the
+     * interrupt; without it the task sleeps until the conversion time has
+     * passed and confirms with one OS poll. If the task is delayed long
+     * enough that the next conversion may already have replaced a result,
+     * that entry is converted again without overlap.
+     *
+     * @param[in] device_handle Pointer to I2C device handle (must not be NULL)
+     * @param[in] config Base configuration for comparator settings (must not be NULL)
+     * @param[in] entries Scan list (must not be NULL)
+     * @param[in] entry_count Number of scan list entries (must be non-zero)
+     * @param[in] rdy Conversion-ready context, or NULL to poll the OS bit
+     * @param[out] results Result block with entry_count elements (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL, the list is empty
+     *         or any entry is not a defined setting (checked before any write)
+     * @return ESP_ERR_TIMEOUT if a conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Results hold raw counts; scale with ads1115_get_pga_voltage_scale()
+     * @note Results before a failing entry remain valid
+     */
+    esp_err_t ads1115_scan(i2c_master_dev_handle_t* device_handle,
+        const ads1115_config_t* config,
+        const ads1115_scan_entry_t* entries,
+        size_t entry_count,
+        ads1115_rdy_t* rdy,
+        ads1115_scan_result_t* results);
+
+    /**
+     * @brief Initialize a shadow-register device handle
+     *
+     * @param[out] handle Pointer to handle to initialize (must not be NULL)
+     * @param[in] device I2C device handle (must not be NULL)
+     * @param[in] verify_writes Read back every config write and compare
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     *
+     * @note No bus traffic; all shadows start invalid
+     */
+    esp_err_t ads1115_handle_init(ads1115_handle_t* handle,
+        i2c_master_dev_handle_t device,
+        bool verify_writes);
+
+    /**
+     * @brief Invalidate all shadow registers
+     *
+     * Call after anything outside this handle may have touched the device
+     * (general-call reset, power cycle, another driver).
+     *
+     * @param[in,out] handle Pointer to handle (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if handle is NULL
+     */
+    esp_err_t ads1115_handle_invalidate(ads1115_handle_t* handle);
+
+    /**
+     * @brief Configure the device through the shadow registers
+     *
+     * Skips the write when the shadow config register already matches. With
+     * verify_writes set, the register is read back after a write and
+     * compared.
+     *
+     * @param[in,out] handle Pointer to handle (must not be NULL)
+     * @param[in,out] config Pointer to configuration structure (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return ESP_ERR_INVALID_RESPONSE if the read-back does not match
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Updates config->voltage_scale
+     */
+    esp_err_t ads1115_handle_configure(ads1115_handle_t* handle,
+        ads1115_config_t* config);
+
+    /**
+     * @brief Write the comparator threshold registers
+     *
+     * Only registers whose shadow differs are written.
+     *
+     * @param[in,out] handle Pointer to handle (must not be NULL)
+     * @param[in] lo_thresh Lo_thresh value in counts
+     * @param[in] hi_thresh Hi_thresh value in counts
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if handle is NULL
+     * @return Other ESP error codes for I2C communication failures
+     */
+    esp_err_t ads1115_handle_write_thresholds(ads1115_handle_t* handle,
+        int16_t lo_thresh,
+        int16_t hi_thresh);
+
+    /**
+     * @brief Read one raw conversion through the shadow registers
+     *
+     * Single-shot mode: starts, waits for and reads a conversion. Continuous
+     * mode: writes the config only if it differs from the shadow, then
+     * reads the conversion register, as a bare 2-byte read when the address
+     * pointer is already there.
+     *
+     * After a config write in continuous mode the conversion register still
+     * holds a result taken with the previous mux and PGA, so the read waits
+     * for the first conversion with the new settings: the ALERT/RDY pulse
+     * when rdy is enabled, otherwise ads1115_get_conversion_time_us() from
+     * the write. Reads with an unchanged config do not wait.
+     *
+     * @param[in,out] handle Pointer to handle (must not be NULL)
+     * @param[in] config Pointer to configuration structure (must not be NULL)
+     * @param[in] rdy Conversion-ready context, or NULL to poll the OS bit
+     *                (single-shot) or wait the conversion time (continuous).
+     *                When enabled, the comparator fields are forced to
+     *                conversion-ready signalling in both modes.
+     * @param[out] raw Pointer to store the signed result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return ESP_ERR_TIMEOUT if a single-shot conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     */
+    esp_err_t ads1115_handle_read_raw(ads1115_handle_t* handle,
+        const ads1115_config_t* config,
+        ads1115_rdy_t* rdy,
+        int16_t* raw);
+
+    /**
+     * @brief Start a single-shot conversion without waiting for it
+     *
+     * Writes the config register with OS set. Used to overlap conversions
+     * on several devices; collect the result with
+     * ads1115_handle_read_conversion() once
+     * ads1115_get_conversion_time_us() has elapsed.
+     *
+     * @param[in,out] handle Pointer to handle (must not be NULL)
+     * @param[in] config Pointer to configuration structure (mode is ignored, must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return Other ESP error codes for I2C communication failures
+     */
+    esp_err_t ads1115_handle_start_single(ads1115_handle_t* handle,
+        const ads1115_config_t* config);
+
+    /**
+     * @brief Read the conversion register
+     *
+     * @param[in,out] handle Pointer to handle (must not be NULL)
+     * @param[out] raw Pointer to store the signed result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Does not check the OS bit; the caller is responsible for timing
+     */
+    esp_err_t ads1115_handle_read_conversion(ads1115_handle_t* handle,
+        int16_t* raw);
+
+    /**
+     * @brief Validate a channel configuration and serialize it
+     *
+     * Does all per-read work that only depends on the configuration once:
+     * parameter validation, building the config word, the conversion time
+     * and the polling interval.
+     *
+     * @param[in] config Pointer to configuration structure (must not be NULL)
+     * @param[out] prepared Pointer to descriptor output (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL or any field is not a defined setting
+     *
+     * @note No bus traffic
+     */
+    esp_err_t ads1115_prepare(const ads1115_config_t* config,
+        ads1115_prepared_t* prepared);
+
+    /**
+     * @brief Execute a prepared descriptor
+     *
+     * Single-shot descriptors write the config word, wait the conversion
+     * time (yielding, see ads1115_delay_us()), poll the OS bit with bare
+     * reads and read the conversion register. Continuous descriptors only read the conversion register.
+     *
+     * @param[in] device I2C device handle (must be valid)
+     * @param[in] prepared Descriptor from ads1115_prepare() (must be valid)
+     * @param[out] raw Pointer to store the signed result (must be valid)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_TIMEOUT if the conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Hot path: arguments are not validated
+     * @note Continuous descriptors require the device to be running in
+     *       continuous mode already (see ads1115_configure())
+     */
+    esp_err_t ads1115_execute(i2c_master_dev_handle_t device,
+        const ads1115_prepared_t* prepared,
+        int16_t* raw);
+
+    /**
+     * @brief Execute a prepared descriptor, completing on ALERT/RDY
+     *
+     * Same as ads1115_execute(), but a single-shot conversion is started
+     * with the comparator fields forced to conversion-ready signalling and
+     * the task blocks on the ALERT/RDY notification instead of waiting the
+     * conversion time. Falls back to OS polling after twice the conversion
+     * time. Continuous descriptors behave as in ads1115_execute().
+     *
+     * @param[in] device I2C device handle (must be valid)
+     * @param[in] prepared Descriptor from ads1115_prepare() (must be valid)
+     * @param[in,out] rdy Conversion-ready context, or NULL for ads1115_execute() behaviour
+     * @param[out] raw Pointer to store the signed result (must be valid)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_TIMEOUT if the conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Hot path: arguments are not validated
+     */
+    esp_err_t ads1115_execute_rdy(i2c_master_dev_handle_t device,
+        const ads1115_prepared_t* prepared,
+        ads1115_rdy_t* rdy,
+        int16_t* raw);
+
+    /**
+     * @brief Read the bus traffic counters
+     *
+     * @param[in] handle Pointer to handle (must not be NULL)
+     * @param[out] stats Pointer to counters output (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     */
+    esp_err_t ads1115_handle_get_stats(const ads1115_handle_t* handle,
+        ads1115_bus_stats_t* stats);
+
+    /**
+     * @brief Clear the bus traffic counters
+     *
+     * @param[in,out] handle Pointer to handle (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if handle is NULL
+     */
+    esp_err_t ads1115_handle_reset_stats(ads1115_handle_t* handle);
+
 #ifdef __cplusplus
 }
 #endif
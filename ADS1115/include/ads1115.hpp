@@ -0,0 +1,131 @@
+#ifndef ADS1115_HPP_
+#define ADS1115_HPP_
+
+/**
+ * @file ads1115.hpp
+ * @brief Compile-time ADS1115 channel descriptors for C++
+ *
+ * Builds the same ads1115_prepared_t that ads1115_prepare() produces, but
+ * entirely at compile time from template parameters, so a fixed channel
+ * table costs nothing at start-up and lives in flash:
+ *
+ * @code
+ * using Battery = ads1115::channel<ADS1115_MUX_AIN0_GND, ADS1115_PGA_4_096V, ADS1115_DR_860_SPS>;
+ *
+ * int16_t raw;
+ * ESP_ERROR_CHECK(Battery::read(device, &raw));
+ * int32_t uv = ads1115_raw_to_microvolts(raw, Battery::pga);
+ * @endcode
+ *
+ * Comparator fields take the ads1115_init_default_config() values
+ * (comparator disabled). Requires C++17 (inline static constexpr members).
+ *
+ * @author Adithya Venkata Narayanan
+ * @version 1.1.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ads1115.h"
+
+namespace ads1115 {
+
+    namespace detail {
+
+        /** Nominal conversion period in microseconds; same table as ads1115_get_data_rate_period_us() */
+        constexpr uint32_t data_rate_period_us(ads1115_data_rate_t data_rate)
+        {
+            constexpr uint32_t periods_us[] = ADS1115_DATA_RATE_PERIODS_US;
+
+            return periods_us[(static_cast<uint32_t>(data_rate) >> 5U) & 0x07U];
+        }
+
+        /** Same result as ads1115_get_conversion_time_us() */
+        constexpr uint32_t conversion_time_us(ads1115_data_rate_t data_rate)
+        {
+            return data_rate_period_us(data_rate) +
+                ((data_rate_period_us(data_rate) * ADS1115_CONVERSION_MARGIN_PCT) / 100U);
+        }
+
+        /** OS polling interval used by ads1115_execute() */
+        constexpr uint32_t poll_interval_us(ads1115_data_rate_t data_rate)
+        {
+            return ((conversion_time_us(data_rate) / 8U) < ADS1115_OS_POLL_MIN_US) ?
+                ADS1115_OS_POLL_MIN_US : (conversion_time_us(data_rate) / 8U);
+        }
+
+        /** Config word as written by ads1115_prepare() with default comparator fields */
+        constexpr uint16_t config_word(ads1115_input_mux_t mux, ads1115_pga_t pga,
+            ads1115_mode_t mode, ads1115_data_rate_t data_rate)
+        {
+            return static_cast<uint16_t>(static_cast<uint32_t>(ADS1115_OS_START_SINGLE) |
+                static_cast<uint32_t>(mux) |
+                static_cast<uint32_t>(pga) |
+                static_cast<uint32_t>(mode) |
+                static_cast<uint32_t>(data_rate) |
+                static_cast<uint32_t>(ADS1115_COMP_MODE_TRADITIONAL) |
+                static_cast<uint32_t>(ADS1115_COMP_POL_LOW) |
+                static_cast<uint32_t>(ADS1115_COMP_LAT_DISABLED) |
+                static_cast<uint32_t>(ADS1115_COMP_QUEUE_DISABLE));
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Compile-time channel
+     *
+     * @tparam Mux Input multiplexer setting
+     * @tparam Pga PGA setting
+     * @tparam DataRate Data rate
+     * @tparam Mode Single-shot (default) or continuous
+     */
+    template <ads1115_input_mux_t Mux,
+        ads1115_pga_t Pga,
+        ads1115_data_rate_t DataRate,
+        ads1115_mode_t Mode = ADS1115_MODE_SINGLE>
+    struct channel {
+        static constexpr ads1115_pga_t pga = Pga;
+        static constexpr uint16_t config_word = detail::config_word(Mux, Pga, Mode, DataRate);
+        static constexpr uint32_t conversion_us = detail::conversion_time_us(DataRate);
+
+        /** Descriptor for ads1115_execute() */
+        static constexpr ads1115_prepared_t descriptor = {
+            { static_cast<uint8_t>(ADS1115_REG_CONFIG),
+              static_cast<uint8_t>(config_word >> 8U),
+              static_cast<uint8_t>(config_word & 0xFFU) },
+            static_cast<uint8_t>(ADS1115_REG_CONVERSION),
+            Mode == ADS1115_MODE_SINGLE,
+            conversion_us,
+            detail::poll_interval_us(DataRate),
+            Pga
+        };
+
+        /** Run the descriptor; see ads1115_execute() */
+        static esp_err_t read(i2c_master_dev_handle_t device, int16_t* raw)
+        {
+            return ads1115_execute(device, &descriptor, raw);
+        }
+
+        /** Run the descriptor, completing on ALERT/RDY; see ads1115_execute_rdy() */
+        static esp_err_t read(i2c_master_dev_handle_t device, ads1115_rdy_t* rdy, int16_t* raw)
+        {
+            return ads1115_execute_rdy(device, &descriptor, rdy, raw);
+        }
+    };
+
+    /**
+     * @brief Compile-time descriptor for a channel
+     */
+    template <ads1115_input_mux_t Mux,
+        ads1115_pga_t Pga,
+        ads1115_data_rate_t DataRate,
+        ads1115_mode_t Mode = ADS1115_MODE_SINGLE>
+    constexpr ads1115_prepared_t make_descriptor()
+    {
+        return channel<Mux, Pga, DataRate, Mode>::descriptor;
+    }
+
+} // namespace ads1115
+
+#endif /* ADS1115_HPP_ */
@@ -0,0 +1,155 @@
+#ifndef ADS1115_AUTORANGE_H_
+#define ADS1115_AUTORANGE_H_
+
+/**
+ * @file ads1115_autorange.h
+ * @brief ADS1115 auto-ranging PGA with hysteresis
+ *
+ * Each channel keeps its own range state. The result of one conversion
+ * predicts the PGA for the next one on the same channel, so no extra
+ * conversion is spent choosing a gain:
+ * - A saturated result jumps straight to the widest allowed range.
+ * - Above the downshift level the gain is lowered to the highest gain the
+ *   last value fits in below the upshift level.
+ * - Below that, the gain is only raised when the value would still land
+ *   below the upshift level at the higher gain.
+ * The band between the two levels holds the current range, so a signal near
+ * a range boundary does not toggle the PGA on every sample.
+ *
+ * Every result carries the PGA it was converted with; scale it with
+ * ads1115_get_pga_voltage_scale(result.pga), never with the current state.
+ *
+ * @author Adithya Venkata Narayanan
+ * @version 1.1.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ads1115.h"
+
+/* CERT-C Compliant Constants */
+#define ADS1115_AUTORANGE_UPSHIFT_COUNTS    (24576U)   /**< 75% of full scale */
+#define ADS1115_AUTORANGE_DOWNSHIFT_COUNTS  (31129U)   /**< 95% of full scale */
+
+/**
+ * @brief Auto-range limits and hysteresis levels
+ */
+typedef struct {
+    ads1115_pga_t widest_pga;               /**< Widest range allowed (e.g. limited by VDD) */
+    ads1115_pga_t narrowest_pga;            /**< Narrowest range allowed */
+    uint16_t upshift_counts;                /**< Raise gain only if the result would stay below this */
+    uint16_t downshift_counts;              /**< Lower gain when |raw| exceeds this */
+} ads1115_autorange_config_t;
+
+/**
+ * @brief Per-channel auto-range state
+ */
+typedef struct {
+    ads1115_autorange_config_t config;      /**< Limits and hysteresis levels */
+    ads1115_pga_t pga;                      /**< PGA for the next conversion */
+    uint32_t range_changes;                 /**< Number of PGA changes */
+    uint32_t saturations;                   /**< Number of saturated results */
+} ads1115_autorange_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Initialize auto-range limits with defaults
+     *
+     * @param[out] config Pointer to auto-range configuration (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if config is NULL
+     *
+     * @note Defaults: ±6.144V to ±0.256V, upshift below 75% and downshift
+     *       above 95% of full scale
+     */
+    esp_err_t ads1115_autorange_init_default_config(ads1115_autorange_config_t* config);
+
+    /**
+     * @brief Initialize the state of one channel
+     *
+     * @param[out] state Pointer to channel state (must not be NULL)
+     * @param[in] config Pointer to auto-range configuration (must not be NULL)
+     * @param[in] initial_pga PGA for the first conversion (clamped to the limits)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL, the limits are
+     *         reversed or downshift_counts is not above upshift_counts
+     */
+    esp_err_t ads1115_autorange_init(ads1115_autorange_t* state,
+        const ads1115_autorange_config_t* config,
+        ads1115_pga_t initial_pga);
+
+    /**
+     * @brief Feed one result into the range predictor
+     *
+     * Use directly when results come from another path (e.g. streaming).
+     *
+     * @param[in,out] state Pointer to channel state (must not be NULL)
+     * @param[in] raw Raw result
+     * @param[in] pga PGA the result was converted with
+     *
+     * @return PGA for the next conversion (ADS1115_PGA_2_048V if state is NULL)
+     */
+    ads1115_pga_t ads1115_autorange_update(ads1115_autorange_t* state,
+        int16_t raw,
+        ads1115_pga_t pga);
+
+    /**
+     * @brief Convert one auto-ranged sample
+     *
+     * Runs a single-shot conversion with the predicted PGA and updates the
+     * prediction from its result.
+     *
+     * @param[in,out] handle Pointer to device handle (must not be NULL)
+     * @param[in] config Base configuration; pga and mode are overridden (must not be NULL)
+     * @param[in,out] state Pointer to channel state (must not be NULL)
+     * @param[in] rdy Conversion-ready context, or NULL to poll the OS bit
+     * @param[out] result Raw value, PGA used, start time and saturation flag (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return ESP_ERR_TIMEOUT if the conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     */
+    esp_err_t ads1115_autorange_read(ads1115_handle_t* handle,
+        const ads1115_config_t* config,
+        ads1115_autorange_t* state,
+        ads1115_rdy_t* rdy,
+        ads1115_scan_result_t* result);
+
+    /**
+     * @brief Run a scan list with one auto-range state per entry
+     *
+     * The PGA field of each entry is ignored in favour of its state.
+     *
+     * @param[in,out] handle Pointer to device handle (must not be NULL)
+     * @param[in] config Base configuration for comparator settings (must not be NULL)
+     * @param[in] entries Scan list (must not be NULL)
+     * @param[in] entry_count Number of scan list entries (must be non-zero)
+     * @param[in,out] states Auto-range states, entry_count elements (must not be NULL)
+     * @param[in] rdy Conversion-ready context, or NULL to poll the OS bit
+     * @param[out] results Result block with entry_count elements (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL or the list is empty
+     * @return ESP_ERR_TIMEOUT if a conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     */
+    esp_err_t ads1115_autorange_scan(ads1115_handle_t* handle,
+        const ads1115_config_t* config,
+        const ads1115_scan_entry_t* entries,
+        size_t entry_count,
+        ads1115_autorange_t* states,
+        ads1115_rdy_t* rdy,
+        ads1115_scan_result_t* results);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADS1115_AUTORANGE_H_ */
@@ -0,0 +1,152 @@
+#ifndef ADS1115_BANK_H_
+#define ADS1115_BANK_H_
+
+/**
+ * @file ads1115_bank.h
+ * @brief ADS1115 multi-chip bank with overlapped conversions
+ *
+ * Up to four ADS1115 devices share one bus (ADDR strapped to 0x48-0x4B).
+ * For each input in the scan list, single-shot conversions are started on
+ * every chip back-to-back, so all chips convert in parallel. Each chip's
+ * result is read just before its next conversion is started, and the only
+ * wait per input is whatever part of one conversion time the bus traffic
+ * has not already covered.
+ *
+ * A frame with four chips and four inputs takes roughly four conversion
+ * times (plus bus time) instead of sixteen.
+ *
+ * The ADS1115 has no general-call conversion start; the only general-call
+ * command it decodes is reset (0x06). ads1115_bank_general_call_reset()
+ * uses it to return every chip on the bus to its power-on state at once.
+ *
+ * @author Adithya Venkata Narayanan
+ * @version 1.1.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ads1115.h"
+
+/* CERT-C Compliant Constants */
+#define ADS1115_BANK_MAX_CHIPS          (4U)       /**< ADDR pin allows 0x48-0x4B */
+#define ADS1115_BANK_MAX_INPUTS         (4U)       /**< Inputs converted per chip per frame */
+#define ADS1115_BANK_MAX_CHANNELS       (ADS1115_BANK_MAX_CHIPS * ADS1115_BANK_MAX_INPUTS)
+#define ADS1115_GENERAL_CALL_ADDRESS    (0x00U)    /**< I2C general-call address */
+#define ADS1115_GENERAL_CALL_RESET      (0x06U)    /**< General-call reset command */
+
+/**
+ * @brief Bank of ADS1115 devices on one bus
+ *
+ * Initialize with ads1115_bank_init(). Each chip keeps its own shadow
+ * registers and bus counters.
+ */
+typedef struct {
+    ads1115_handle_t chips[ADS1115_BANK_MAX_CHIPS];  /**< Per-chip handles */
+    size_t chip_count;                                /**< Number of chips in use */
+} ads1115_bank_t;
+
+/**
+ * @brief One bank frame
+ *
+ * raw[chip * input_count + input] holds the result of scan list entry
+ * `input` on chip `chip`.
+ */
+typedef struct {
+    int16_t raw[ADS1115_BANK_MAX_CHANNELS];          /**< Raw conversion results */
+    ads1115_pga_t pga[ADS1115_BANK_MAX_INPUTS];      /**< PGA used for each input */
+    size_t channel_count;                            /**< chip_count * input_count */
+    size_t input_count;                              /**< Scan list length */
+    int64_t timestamp_us;                            /**< esp_timer time of the first conversion start */
+    uint32_t duration_us;                            /**< First start to last read */
+} ads1115_bank_frame_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Initialize a bank from existing device handles
+     *
+     * @param[out] bank Pointer to bank to initialize (must not be NULL)
+     * @param[in] devices Array of I2C device handles, one per chip (must not be NULL)
+     * @param[in] chip_count Number of devices (1 to ADS1115_BANK_MAX_CHIPS)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are invalid
+     *
+     * @note No bus traffic
+     */
+    esp_err_t ads1115_bank_init(ads1115_bank_t* bank,
+        const i2c_master_dev_handle_t* devices,
+        size_t chip_count);
+
+    /**
+     * @brief Convert a scan list on every chip with overlapped conversions
+     *
+     * For each entry, single-shot conversions are started on all chips in
+     * turn, then the results are read in the same order once the
+     * worst-case conversion time has elapsed since the first start. Reading
+     * a chip and starting its next entry are back-to-back, so the next
+     * entry's conversions overlap the remaining reads.
+     *
+     * @param[in,out] bank Pointer to bank (must not be NULL)
+     * @param[in] config Base configuration for comparator settings (must not be NULL)
+     * @param[in] entries Scan list applied to every chip (must not be NULL)
+     * @param[in] entry_count Number of entries (1 to ADS1115_BANK_MAX_INPUTS)
+     * @param[out] frame Pointer to frame output (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are invalid
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Results are read after ads1115_get_conversion_time_us(), which
+     *       includes the oscillator tolerance; the OS bit is not polled
+     * @note Comparator fields in config must not enable conversion-ready
+     *       mode on a shared ALERT/RDY line
+     */
+    esp_err_t ads1115_bank_read_frame(ads1115_bank_t* bank,
+        const ads1115_config_t* config,
+        const ads1115_scan_entry_t* entries,
+        size_t entry_count,
+        ads1115_bank_frame_t* frame);
+
+    /**
+     * @brief Reset every ADS1115 on the bus with one general-call command
+     *
+     * Sends 0x06 to the general-call address, returning all chips to their
+     * power-on defaults (single-shot, powered down), and invalidates the
+     * bank's shadow registers.
+     *
+     * @param[in] bus I2C bus handle (must not be NULL)
+     * @param[in] scl_speed_hz Bus speed for the general-call transfer
+     * @param[in,out] bank Pointer to bank to invalidate, or NULL
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if bus is NULL
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note Other devices on the bus that decode general-call reset are
+     *       reset as well
+     */
+    esp_err_t ads1115_bank_general_call_reset(i2c_master_bus_handle_t bus,
+        uint32_t scl_speed_hz,
+        ads1115_bank_t* bank);
+
+    /**
+     * @brief Sum the bus counters of every chip in the bank
+     *
+     * @param[in] bank Pointer to bank (must not be NULL)
+     * @param[out] stats Pointer to counters output (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     */
+    esp_err_t ads1115_bank_get_stats(const ads1115_bank_t* bank,
+        ads1115_bus_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADS1115_BANK_H_ */
@@ -0,0 +1,146 @@
+#ifndef ADS1115_BENCH_H_
+#define ADS1115_BENCH_H_
+
+/**
+ * @file ads1115_bench.h
+ * @brief ADS1115 on-target CPU cost benchmarks
+ *
+ * Measures CPU cycles of the sample processing paths on the running target
+ * with esp_cpu_get_cycle_count(). No I2C traffic is generated; the input
+ * block is filled with a deterministic full-scale ramp.
+ *
+ * @author Adithya Venkata Narayanan
+ * @version 1.1.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ads1115.h"
+#include "ads1115_convert.h"
+#include "ads1115_filter.h"
+
+/**
+ * @brief Conversion benchmark result
+ *
+ * Cycle counts cover the whole block; divide by samples for per-sample cost.
+ */
+typedef struct {
+    uint32_t samples;                       /**< Samples per measured block */
+    uint32_t scalar_cycles;                 /**< Per-sample float conversion (legacy path) */
+    uint32_t batch_volts_cycles;            /**< ads1115_convert_to_volts() */
+    uint32_t batch_microvolts_cycles;       /**< ads1115_convert_to_microvolts() */
+} ads1115_bench_convert_t;
+
+/**
+ * @brief Fixed-point versus float benchmark result
+ *
+ * Cycle counts cover the whole block; divide by samples for per-sample cost.
+ */
+typedef struct {
+    uint32_t samples;                       /**< Samples per measured block */
+    uint32_t float_cycles;                  /**< Per-sample float volts (legacy path) */
+    uint32_t fixed_cycles;                  /**< Per-sample ads1115_raw_to_microvolts() */
+    uint32_t batch_fixed_cycles;            /**< ads1115_convert_pga_to_microvolts() */
+    float max_error_uv;                     /**< Largest |fixed - float| difference in uV */
+} ads1115_bench_fixed_point_t;
+
+/**
+ * @brief Filter benchmark result
+ *
+ * Cycle counts cover the whole block; divide by samples for per-sample cost.
+ */
+typedef struct {
+    uint32_t samples;                       /**< Input samples per measured block */
+    uint32_t outputs;                       /**< Filter outputs produced */
+    uint32_t float_cycles;                  /**< Naive per-sample float block average */
+    uint32_t fixed_cycles;                  /**< ads1115_filter_process() */
+} ads1115_bench_filter_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Benchmark per-sample versus batch conversion
+     *
+     * Fills raw with a ramp, then times the per-sample conversion used by
+     * ads1115_read_single_shot() against the batch converters.
+     *
+     * @param[out] raw Scratch input block with count elements (must not be NULL)
+     * @param[out] volts Scratch float block with count elements (must not be NULL)
+     * @param[out] microvolts Scratch int32 block with count elements (must not be NULL)
+     * @param[in] count Number of samples (must be non-zero)
+     * @param[out] result Pointer to benchmark result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are invalid
+     *
+     * @note Run from a task pinned to one core; cycle counters are per core
+     */
+    esp_err_t ads1115_bench_convert(int16_t* raw,
+        float* volts,
+        int32_t* microvolts,
+        size_t count,
+        ads1115_bench_convert_t* result);
+
+    /**
+     * @brief Benchmark the fixed-point output path against the float path
+     *
+     * Fills raw with a ramp and times per-sample float volts, per-sample
+     * integer microvolts and the integer batch converter for one PGA
+     * setting, then checks the two paths agree within
+     * ADS1115_UV_TOLERANCE. Run it on each target; on FPU-less RISC-V
+     * parts (ESP32-C3/C6) the float path uses soft-float calls.
+     *
+     * @param[out] raw Scratch input block with count elements (must not be NULL)
+     * @param[out] volts Scratch float block with count elements (must not be NULL)
+     * @param[out] microvolts Scratch int32 block with count elements (must not be NULL)
+     * @param[in] count Number of samples (must be non-zero)
+     * @param[in] pga PGA setting to benchmark
+     * @param[out] result Pointer to benchmark result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are invalid
+     * @return ESP_ERR_INVALID_RESPONSE if the paths disagree beyond the tolerance
+     *
+     * @note Run from a task pinned to one core; cycle counters are per core
+     */
+    esp_err_t ads1115_bench_fixed_point(int16_t* raw,
+        float* volts,
+        int32_t* microvolts,
+        size_t count,
+        ads1115_pga_t pga,
+        ads1115_bench_fixed_point_t* result);
+
+    /**
+     * @brief Benchmark a fixed-point filter against a naive float loop
+     *
+     * The reference is the usual application loop: convert each sample to
+     * volts and average every `decimation` samples in float, one sample at
+     * a time. The filter under test processes the same ramp as one block.
+     *
+     * @param[out] raw Scratch input block with count elements (must not be NULL)
+     * @param[out] volts Scratch float output with count elements (must not be NULL)
+     * @param[out] filtered Scratch filter output with count elements (must not be NULL)
+     * @param[in] count Number of samples (must be non-zero)
+     * @param[in] filter_config Filter under test (must not be NULL)
+     * @param[out] result Pointer to benchmark result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are invalid
+     *
+     * @note Run from a task pinned to one core; cycle counters are per core
+     */
+    esp_err_t ads1115_bench_filter(int16_t* raw,
+        float* volts,
+        int32_t* filtered,
+        size_t count,
+        const ads1115_filter_config_t* filter_config,
+        ads1115_bench_filter_t* result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADS1115_BENCH_H_ */
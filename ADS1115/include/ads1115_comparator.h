@@ -0,0 +1,190 @@
+#ifndef ADS1115_COMPARATOR_H_
+#define ADS1115_COMPARATOR_H_
+
+/**
+ * @file ads1115_comparator.h
+ * @brief ADS1115 hardware comparator events
+ *
+ * The device runs in continuous mode with its digital comparator enabled
+ * and the threshold registers programmed from volts. The CPU and the bus
+ * stay idle until ALERT/RDY asserts; the ALERT ISR then posts a timestamped
+ * event to a FreeRTOS queue and/or calls a callback.
+ *
+ * The ISR masks the ALERT interrupt after each event, so a latched or
+ * still-asserted comparator produces exactly one event.
+ * ads1115_comparator_acknowledge() reads the conversion register (which
+ * clears a latched ALERT) and unmasks the interrupt.
+ *
+ * With light-sleep wake enabled, ALERT/RDY is also a GPIO wake-up source
+ * and uses a level interrupt, so the chip can sit in automatic or manual
+ * light sleep between events.
+ *
+ * Comparator modes (ADS1115 datasheet 9.3.8):
+ * - Traditional: asserts above hi_thresh, deasserts below lo_thresh
+ *   (hysteresis).
+ * - Window: asserts above hi_thresh or below lo_thresh.
+ *
+ * @author Adithya Venkata Narayanan
+ * @version 1.1.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ads1115.h"
+#include "freertos/queue.h"
+#include "esp_sleep.h"
+
+/**
+ * @brief Comparator event, produced in ISR context
+ */
+typedef struct {
+    gpio_num_t alert_io;                    /**< ALERT/RDY GPIO that fired */
+    int64_t timestamp_us;                   /**< esp_timer time of the interrupt */
+    uint32_t sequence;                      /**< Event counter, gaps mean queue drops */
+} ads1115_comparator_event_t;
+
+/**
+ * @brief Comparator event callback
+ *
+ * Called from the ALERT ISR. Must be short, must not block and may only use
+ * ISR-safe APIs; place it in IRAM.
+ */
+typedef void (*ads1115_comparator_callback_t)(const ads1115_comparator_event_t* event, void* arg);
+
+/**
+ * @brief Comparator configuration
+ */
+typedef struct {
+    ads1115_config_t config;                /**< Channel, PGA, data rate and comparator fields */
+    float lo_thresh_v;                      /**< Lower threshold in volts */
+    float hi_thresh_v;                      /**< Upper threshold in volts */
+    gpio_num_t alert_io;                    /**< GPIO connected to ALERT/RDY */
+    QueueHandle_t queue;                    /**< Event queue (item size sizeof(ads1115_comparator_event_t)), or NULL */
+    ads1115_comparator_callback_t callback; /**< ISR callback, or NULL */
+    void* callback_arg;                     /**< Argument passed to callback */
+    bool light_sleep_wake;                  /**< Enable ALERT as a light-sleep wake-up source */
+} ads1115_comparator_config_t;
+
+/**
+ * @brief Comparator state
+ *
+ * Allocated by the caller; all fields are internal.
+ */
+typedef struct {
+    ads1115_handle_t* handle;               /**< Device handle */
+    ads1115_config_t config;                /**< Applied continuous-mode configuration */
+    gpio_num_t alert_io;                    /**< ALERT/RDY GPIO */
+    QueueHandle_t queue;                    /**< Event queue, or NULL */
+    ads1115_comparator_callback_t callback; /**< ISR callback, or NULL */
+    void* callback_arg;                     /**< Callback argument */
+    volatile uint32_t events;               /**< Events raised */
+    volatile uint32_t dropped;              /**< Events lost to a full queue */
+    volatile bool masked;                   /**< ISR masked the interrupt, not acknowledged yet */
+    bool light_sleep_wake;                  /**< Wake-up source installed */
+    bool running;                           /**< True between start and stop */
+} ads1115_comparator_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Initialize a comparator configuration with safe defaults
+     *
+     * @param[out] comparator_config Pointer to configuration to initialize (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if comparator_config is NULL
+     *
+     * @note Defaults: AIN0 single-ended, ±4.096V, 8 SPS, traditional
+     *       comparator, active low, latching, assert after 2 conversions.
+     *       Thresholds, alert_io and an event sink must be set by the caller.
+     */
+    esp_err_t ads1115_comparator_init_default_config(ads1115_comparator_config_t* comparator_config);
+
+    /**
+     * @brief Convert a voltage to threshold register counts
+     *
+     * @param[in] volts Threshold voltage
+     * @param[in] pga PGA setting the threshold applies to
+     *
+     * @return Counts, rounded to nearest and clamped to the 16-bit range
+     */
+    int16_t ads1115_comparator_volts_to_counts(float volts, ads1115_pga_t pga);
+
+    /**
+     * @brief Program the comparator and start delivering events
+     *
+     * Writes the thresholds, installs the ALERT ISR (and optionally the
+     * light-sleep wake-up source) and then starts continuous conversion.
+     *
+     * @param[in,out] handle Pointer to device handle (must not be NULL)
+     * @param[in] comparator_config Pointer to configuration (must not be NULL)
+     * @param[out] comparator Pointer to comparator state (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are invalid, lo_thresh_v is
+     *         not below hi_thresh_v, the comparator queue is disabled or
+     *         neither queue nor callback is set
+     * @return Other ESP error codes for I2C or GPIO failures
+     */
+    esp_err_t ads1115_comparator_start(ads1115_handle_t* handle,
+        const ads1115_comparator_config_t* comparator_config,
+        ads1115_comparator_t* comparator);
+
+    /**
+     * @brief Read the value behind an event and re-arm the interrupt
+     *
+     * Reading the conversion register clears a latched ALERT.
+     *
+     * @param[in,out] comparator Pointer to comparator state (must not be NULL)
+     * @param[out] raw Pointer to store the current raw result, or NULL
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if comparator is NULL
+     * @return ESP_ERR_INVALID_STATE if the comparator is not running
+     * @return Other ESP error codes for I2C communication failures
+     */
+    esp_err_t ads1115_comparator_acknowledge(ads1115_comparator_t* comparator,
+        int16_t* raw);
+
+    /**
+     * @brief Update the thresholds of a running comparator
+     *
+     * @param[in,out] comparator Pointer to comparator state (must not be NULL)
+     * @param[in] lo_thresh_v Lower threshold in volts
+     * @param[in] hi_thresh_v Upper threshold in volts
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if comparator is NULL or lo_thresh_v is not below hi_thresh_v
+     * @return Other ESP error codes for I2C communication failures
+     */
+    esp_err_t ads1115_comparator_set_thresholds(ads1115_comparator_t* comparator,
+        float lo_thresh_v,
+        float hi_thresh_v);
+
+    /**
+     * @brief Stop the comparator
+     *
+     * Removes the ISR, disables GPIO light-sleep wake-up, unmasks an
+     * interrupt left masked by an unacknowledged event and returns the
+     * device to single-shot (power-down) mode with the comparator disabled.
+     *
+     * @note GPIO wake-up is a single system-wide source; stopping the
+     *       comparator disables it for every GPIO
+     *
+     * @param[in,out] comparator Pointer to comparator state (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if comparator is NULL
+     * @return ESP_ERR_INVALID_STATE if the comparator is not running
+     * @return Other ESP error codes for I2C or GPIO failures
+     */
+    esp_err_t ads1115_comparator_stop(ads1115_comparator_t* comparator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADS1115_COMPARATOR_H_ */
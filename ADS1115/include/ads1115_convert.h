@@ -0,0 +1,166 @@
+#ifndef ADS1115_CONVERT_H_
+#define ADS1115_CONVERT_H_
+
+/**
+ * @file ads1115_convert.h
+ * @brief ADS1115 batch conversion of raw samples
+ *
+ * Converts blocks of raw int16 samples to volts or to fixed-point
+ * microvolts, so scaling can run outside the acquisition loop.
+ *
+ * The PGA-indexed microvolt functions never touch a float, for targets
+ * without an FPU (ESP32-C3/C6). Every PGA step is an exact multiple of
+ * 1/128 uV, so the integer result is the exact value rounded half away
+ * from zero (error <= 0.5 uV). Against the float path,
+ * (float)raw * voltage_scale * 1e6 differs by at most 1 uV (0.75 uV worst
+ * case, at ±6.144V, from float rounding of the float path).
+ *
+ * @author Adithya Venkata Narayanan
+ * @version 1.1.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ads1115.h"
+
+/* CERT-C Compliant Constants */
+#define ADS1115_UV_SCALE_SHIFT          (7U)       /**< Fractional bits of the microvolt scale */
+#define ADS1115_UV_SCALE_MAX            (65535)    /**< Largest scale keeping raw * scale in int32 */
+#define ADS1115_UV_TOLERANCE            (1)        /**< Max |fixed - float| path difference in uV */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Convert a block of raw samples to volts
+     *
+     * @param[in] raw Raw samples (must not be NULL)
+     * @param[in] count Number of samples
+     * @param[in] voltage_scale Volts per LSB (config->voltage_scale)
+     * @param[out] volts Output block with count elements (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if pointers are NULL
+     *
+     * @note raw and volts must not overlap
+     */
+    esp_err_t ads1115_convert_to_volts(const int16_t* raw,
+        size_t count,
+        float voltage_scale,
+        float* volts);
+
+    /**
+     * @brief Convert a block of raw samples to integer microvolts
+     *
+     * The scale is converted once per block to microvolts per LSB in
+     * Q(ADS1115_UV_SCALE_SHIFT) fixed point, which is exact for every PGA
+     * setting. Samples are then scaled with integer arithmetic only and
+     * rounded half away from zero.
+     *
+     * @param[in] raw Raw samples (must not be NULL)
+     * @param[in] count Number of samples
+     * @param[in] voltage_scale Volts per LSB (config->voltage_scale)
+     * @param[out] microvolts Output block with count elements (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if pointers are NULL or the scale is out of range
+     *
+     * @note raw and microvolts must not overlap
+     */
+    esp_err_t ads1115_convert_to_microvolts(const int16_t* raw,
+        size_t count,
+        float voltage_scale,
+        int32_t* microvolts);
+
+    /**
+     * @brief Integer microvolt scale of a PGA setting
+     *
+     * @param[in] pga PGA setting
+     *
+     * @return Microvolts per LSB in Q(ADS1115_UV_SCALE_SHIFT) fixed point
+     */
+    int32_t ads1115_get_pga_uv_scale_q7(ads1115_pga_t pga);
+
+    /**
+     * @brief Convert one raw sample to integer microvolts
+     *
+     * Integer only; uses the precomputed Q(ADS1115_UV_SCALE_SHIFT) scale of
+     * the PGA setting.
+     *
+     * @param[in] raw Raw sample
+     * @param[in] pga PGA setting the sample was converted with
+     *
+     * @return Microvolts, rounded half away from zero
+     */
+    int32_t ads1115_raw_to_microvolts(int16_t raw, ads1115_pga_t pga);
+
+    /**
+     * @brief Convert a block of raw samples to integer microvolts by PGA
+     *
+     * Same kernel as ads1115_convert_to_microvolts() with the scale taken
+     * from an integer table, so no floating-point operation is executed.
+     *
+     * @param[in] raw Raw samples (must not be NULL)
+     * @param[in] count Number of samples
+     * @param[in] pga PGA setting the samples were converted with
+     * @param[out] microvolts Output block with count elements (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if pointers are NULL
+     *
+     * @note raw and microvolts must not overlap
+     */
+    esp_err_t ads1115_convert_pga_to_microvolts(const int16_t* raw,
+        size_t count,
+        ads1115_pga_t pga,
+        int32_t* microvolts);
+
+    /**
+     * @brief Read one result as integer microvolts
+     *
+     * Fixed-point counterpart of ads1115_read_single_shot() and
+     * ads1115_read_continuous(), selected by config->mode.
+     *
+     * @param[in] device_handle Pointer to I2C device handle (must not be NULL)
+     * @param[in] config Pointer to configuration structure (must not be NULL)
+     * @param[out] microvolts Pointer to store the result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return ESP_ERR_TIMEOUT if a single-shot conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     *
+     * @note config->data_format and config->voltage_scale are ignored
+     */
+    esp_err_t ads1115_read_microvolts(i2c_master_dev_handle_t* device_handle,
+        const ads1115_config_t* config,
+        int32_t* microvolts);
+
+    /**
+     * @brief Read one result as integer microvolts through a device handle
+     *
+     * Scales with config->pga; a continuous-mode config change waits for a
+     * conversion with the new settings first (see ads1115_handle_read_raw()).
+     *
+     * @param[in,out] handle Pointer to device handle (must not be NULL)
+     * @param[in] config Pointer to configuration structure (must not be NULL)
+     * @param[in] rdy Conversion-ready context, or NULL to poll the OS bit
+     * @param[out] microvolts Pointer to store the result (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     * @return ESP_ERR_TIMEOUT if a single-shot conversion does not complete
+     * @return Other ESP error codes for I2C communication failures
+     */
+    esp_err_t ads1115_handle_read_microvolts(ads1115_handle_t* handle,
+        const ads1115_config_t* config,
+        ads1115_rdy_t* rdy,
+        int32_t* microvolts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADS1115_CONVERT_H_ */
@@ -0,0 +1,167 @@
+#ifndef ADS1115_FILTER_H_
+#define ADS1115_FILTER_H_
+
+/**
+ * @file ads1115_filter.h
+ * @brief ADS1115 fixed-point decimation and oversampling filters
+ *
+ * Per-channel filter state turning an oversampled raw stream into a lower
+ * rate, higher resolution output. Kernels run over blocks with integer
+ * arithmetic only:
+ * - Moving average: boxcar over `length` samples, one output every
+ *   `decimation` samples.
+ * - CIC: `order` integrator/comb stages decimating by `decimation`
+ *   (a power of two), the classic cheap anti-alias decimator.
+ * - Median: median of each block of `length` samples (decimates by
+ *   `length`), rejecting isolated spikes.
+ *
+ * Outputs are raw counts with ADS1115_FILTER_FRAC_BITS fractional bits, so
+ * averaging gains resolution instead of being rounded away. Scale with
+ * ads1115_filter_to_microvolts().
+ *
+ * @author Adithya Venkata Narayanan
+ * @version 1.1.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ads1115.h"
+#include "ads1115_convert.h"
+#include "ads1115_stream.h"
+
+/* CERT-C Compliant Constants */
+#define ADS1115_FILTER_FRAC_BITS        (8U)       /**< Fractional bits of filter outputs */
+#define ADS1115_FILTER_MAX_LENGTH       (64U)      /**< Longest moving-average window */
+#define ADS1115_FILTER_MAX_MEDIAN       (9U)       /**< Longest median block (odd) */
+#define ADS1115_FILTER_MAX_CIC_ORDER    (3U)       /**< Most CIC stages */
+#define ADS1115_FILTER_MAX_CIC_GAIN_LOG2 (15U)     /**< order * log2(decimation) limit keeping int32 headroom */
+
+/**
+ * @brief Filter kernel
+ */
+typedef enum {
+    ADS1115_FILTER_NONE = 0,                /**< Pass through (scaled to the output format) */
+    ADS1115_FILTER_MOVING_AVERAGE,          /**< Boxcar average with decimation */
+    ADS1115_FILTER_CIC,                     /**< Cascaded integrator-comb decimator */
+    ADS1115_FILTER_MEDIAN                   /**< Block median */
+} ads1115_filter_type_t;
+
+/**
+ * @brief Filter configuration
+ */
+typedef struct {
+    ads1115_filter_type_t type;             /**< Kernel */
+    uint8_t length;                         /**< Moving-average window or median block (odd) */
+    uint8_t decimation;                     /**< Output every N inputs (moving average, CIC) */
+    uint8_t order;                          /**< CIC stages (1 to ADS1115_FILTER_MAX_CIC_ORDER) */
+} ads1115_filter_config_t;
+
+/**
+ * @brief Per-channel filter state
+ *
+ * Allocated by the caller; all fields are internal.
+ */
+typedef struct {
+    ads1115_filter_config_t config;         /**< Applied configuration */
+    int16_t history[ADS1115_FILTER_MAX_LENGTH]; /**< Window (moving average) or block (median) */
+    uint32_t integrators[ADS1115_FILTER_MAX_CIC_ORDER]; /**< CIC integrators (modular) */
+    uint32_t combs[ADS1115_FILTER_MAX_CIC_ORDER];       /**< CIC comb delays (modular) */
+    int32_t sum;                            /**< Moving-average running sum */
+    uint32_t index;                         /**< History write index */
+    uint32_t filled;                        /**< Valid history entries */
+    uint32_t phase;                         /**< Inputs since the last output */
+    uint32_t output_decimation;             /**< Inputs per output */
+    uint32_t gain_log2;                     /**< CIC gain as a power of two */
+} ads1115_filter_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Initialize a filter
+     *
+     * @param[out] filter Pointer to filter state (must not be NULL)
+     * @param[in] filter_config Pointer to configuration (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL or out of range
+     */
+    esp_err_t ads1115_filter_init(ads1115_filter_t* filter,
+        const ads1115_filter_config_t* filter_config);
+
+    /**
+     * @brief Clear the filter history, keeping the configuration
+     *
+     * @param[in,out] filter Pointer to filter state (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if filter is NULL
+     */
+    esp_err_t ads1115_filter_reset(ads1115_filter_t* filter);
+
+    /**
+     * @brief Number of inputs consumed per output
+     *
+     * @param[in] filter Pointer to filter state
+     *
+     * @return Decimation factor (0 if filter is NULL)
+     */
+    uint32_t ads1115_filter_get_decimation(const ads1115_filter_t* filter);
+
+    /**
+     * @brief Filter a block of raw samples
+     *
+     * @param[in,out] filter Pointer to filter state (must not be NULL)
+     * @param[in] raw Raw samples (must not be NULL)
+     * @param[in] count Number of samples
+     * @param[out] output Filtered values with ADS1115_FILTER_FRAC_BITS
+     *             fractional bits; room for count / decimation + 1 (must not be NULL)
+     * @param[out] output_count Number of values written (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     */
+    esp_err_t ads1115_filter_process(ads1115_filter_t* filter,
+        const int16_t* raw,
+        size_t count,
+        int32_t* output,
+        size_t* output_count);
+
+    /**
+     * @brief Drain a background stream through a filter
+     *
+     * Consumes samples from the stream ring buffer (peek/release) until it
+     * is empty or output is full.
+     *
+     * @param[in,out] stream Pointer to running stream (must not be NULL)
+     * @param[in,out] filter Pointer to filter state (must not be NULL)
+     * @param[out] output Filtered values (must not be NULL)
+     * @param[in] output_capacity Capacity of output in values
+     * @param[out] output_count Number of values written (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     */
+    esp_err_t ads1115_filter_stream(ads1115_stream_t* stream,
+        ads1115_filter_t* filter,
+        int32_t* output,
+        size_t output_capacity,
+        size_t* output_count);
+
+    /**
+     * @brief Convert a filter output to integer microvolts
+     *
+     * @param[in] value Filter output (ADS1115_FILTER_FRAC_BITS fractional bits)
+     * @param[in] pga PGA setting of the filtered samples
+     *
+     * @return Microvolts, rounded half away from zero
+     */
+    int32_t ads1115_filter_to_microvolts(int32_t value, ads1115_pga_t pga);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADS1115_FILTER_H_ */
@@ -0,0 +1,187 @@
+#ifndef ADS1115_STREAM_H_
+#define ADS1115_STREAM_H_
+
+/**
+ * @file ads1115_stream.h
+ * @brief ADS1115 continuous-mode background streaming
+ *
+ * A dedicated acquisition task keeps the ADS1115 in continuous conversion
+ * mode and pushes raw samples into a single-producer/single-consumer ring
+ * buffer. Consumers borrow contiguous blocks without copying and release
+ * them when done.
+ *
+ * Pacing:
+ * - With ALERT/RDY wired, every conversion-ready pulse triggers one read,
+ *   so each sample is read exactly once and skipped pulses are counted.
+ * - Without ALERT/RDY, an esp_timer paces reads at the nominal data rate
+ *   period, so the average output rate is the configured SPS. Conversions
+ *   skipped because the task ran late are derived from elapsed time and
+ *   counted as missed. The ADS1115 oscillator (up to
+ *   ADS1115_CONVERSION_MARGIN_PCT off) is not visible without ALERT/RDY,
+ *   so drift against it can still read a conversion twice or skip one
+ *   unnoticed; wire ALERT/RDY when every sample must be exact.
+ *
+ * @author Adithya Venkata Narayanan
+ * @version 1.1.0
+ * @date 2024
+ */
+
+#pragma once
+
+#include "ads1115.h"
+
+/* CERT-C Compliant Constants */
+#define ADS1115_STREAM_TASK_STACK_SIZE  (3072U)    /**< Default acquisition task stack */
+#define ADS1115_STREAM_TASK_PRIORITY    (10U)      /**< Default acquisition task priority */
+#define ADS1115_STREAM_STOP_TIMEOUT_MS  (500U)     /**< Time allowed for the task to exit */
+
+/**
+ * @brief Stream configuration
+ */
+typedef struct {
+    ads1115_config_t config;                /**< Channel configuration (mode forced to continuous) */
+    int16_t* buffer;                        /**< Sample storage, owned by the caller */
+    size_t buffer_length;                   /**< Storage length in samples (power of two, >= 2) */
+    gpio_num_t alert_io;                    /**< ALERT/RDY GPIO, or GPIO_NUM_NC for timer pacing */
+    BaseType_t core_id;                     /**< Core for the acquisition task, or tskNO_AFFINITY */
+    UBaseType_t task_priority;              /**< Acquisition task priority */
+    uint32_t task_stack_size;               /**< Acquisition task stack size in bytes */
+} ads1115_stream_config_t;
+
+/**
+ * @brief Stream counters
+ */
+typedef struct {
+    uint32_t produced;                      /**< Samples written to the ring buffer */
+    uint32_t overruns;                      /**< Samples dropped because the ring buffer was full */
+    uint32_t missed;                        /**< Conversions not read before the next one completed */
+    uint32_t read_errors;                   /**< Failed conversion register reads */
+} ads1115_stream_stats_t;
+
+/**
+ * @brief Stream state
+ *
+ * Allocated by the caller; all fields are internal. Ring indices are
+ * free-running and only the producer writes head, only the consumer
+ * writes tail.
+ */
+typedef struct {
+    i2c_master_dev_handle_t device;         /**< I2C device handle */
+    ads1115_config_t config;                /**< Applied continuous-mode configuration */
+    int16_t* buffer;                        /**< Sample storage */
+    uint32_t mask;                          /**< buffer_length - 1 */
+    volatile uint32_t head;                 /**< Producer index */
+    volatile uint32_t tail;                 /**< Consumer index */
+    volatile uint32_t overruns;             /**< Ring-full drops */
+    volatile uint32_t missed;               /**< Skipped conversions */
+    volatile uint32_t read_errors;          /**< Failed reads */
+    int64_t start_us;                       /**< Pacing timer start (timer pacing) */
+    uint32_t period_us;                     /**< Nominal conversion period (timer pacing) */
+    uint32_t last_due;                      /**< Conversions due at the last read (timer pacing) */
+    ads1115_rdy_t rdy;                      /**< Conversion-ready context (ALERT/RDY pacing) */
+    esp_timer_handle_t timer;               /**< Pacing timer (timer pacing) */
+    TaskHandle_t task;                      /**< Acquisition task */
+    volatile bool stop_requested;           /**< Set by ads1115_stream_stop() */
+    volatile bool running;                  /**< True while the acquisition task runs */
+} ads1115_stream_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief Initialize a stream configuration with safe defaults
+     *
+     * @param[out] stream_config Pointer to stream configuration to initialize
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if stream_config is NULL
+     *
+     * @note Default settings: AIN0 single-ended, ±2.048V, 860 SPS, timer
+     *       pacing, no core affinity. buffer and buffer_length must be set
+     *       by the caller.
+     */
+    esp_err_t ads1115_stream_init_default_config(ads1115_stream_config_t* stream_config);
+
+    /**
+     * @brief Start background streaming
+     *
+     * Configures the device for continuous conversion, sets the address
+     * pointer to the conversion register once so every sample is a bare
+     * 2-byte read, and starts the pinned acquisition task.
+     *
+     * @param[in] device_handle Pointer to I2C device handle (must not be NULL)
+     * @param[in] stream_config Pointer to stream configuration (must not be NULL)
+     * @param[out] stream Pointer to stream state (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are invalid
+     * @return ESP_ERR_NO_MEM if the task or timer cannot be created
+     * @return Other ESP error codes for I2C or GPIO failures
+     *
+     * @note No other transaction may be issued to the device while streaming
+     */
+    esp_err_t ads1115_stream_start(i2c_master_dev_handle_t* device_handle,
+        const ads1115_stream_config_t* stream_config,
+        ads1115_stream_t* stream);
+
+    /**
+     * @brief Stop background streaming
+     *
+     * Stops the acquisition task and pacing source and returns the device to
+     * single-shot (power-down) mode. Samples still in the ring buffer remain
+     * readable.
+     *
+     * @param[in,out] stream Pointer to stream state (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if stream is NULL
+     * @return ESP_ERR_INVALID_STATE if the stream is not running
+     * @return ESP_ERR_TIMEOUT if the task does not exit in time
+     */
+    esp_err_t ads1115_stream_stop(ads1115_stream_t* stream);
+
+    /**
+     * @brief Borrow the next contiguous block of samples
+     *
+     * Returns a pointer into the ring buffer without copying. The block
+     * stays valid until it is released with ads1115_stream_release().
+     *
+     * @param[in] stream Pointer to stream state (must not be NULL)
+     * @param[out] block Set to the first sample of the block (must not be NULL)
+     *
+     * @return Number of contiguous samples available (0 if empty or on invalid arguments)
+     *
+     * @note Only one consumer task may borrow from a stream
+     */
+    size_t ads1115_stream_peek(ads1115_stream_t* stream, const int16_t** block);
+
+    /**
+     * @brief Release samples borrowed with ads1115_stream_peek()
+     *
+     * @param[in,out] stream Pointer to stream state (must not be NULL)
+     * @param[in] count Number of samples to release
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if stream is NULL
+     * @return ESP_ERR_INVALID_SIZE if count exceeds the samples available
+     */
+    esp_err_t ads1115_stream_release(ads1115_stream_t* stream, size_t count);
+
+    /**
+     * @brief Read the stream counters
+     *
+     * @param[in] stream Pointer to stream state (must not be NULL)
+     * @param[out] stats Pointer to counters output (must not be NULL)
+     *
+     * @return ESP_OK on success
+     * @return ESP_ERR_INVALID_ARG if parameters are NULL
+     */
+    esp_err_t ads1115_stream_get_stats(const ads1115_stream_t* stream,
+        ads1115_stream_stats_t* stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADS1115_STREAM_H_ */
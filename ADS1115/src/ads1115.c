@@ -23,6 +23,11 @@ static const float PGA_VOLTAGE_SCALES[] = {
     0.0000078125f   /* ±0.256V -> 0.256V / 32768 */
 };
 
+/**
+ * @brief Nominal conversion period for each data rate, indexed by bits 7:5
+ */
+static const uint32_t DATA_RATE_PERIODS_US[] = ADS1115_DATA_RATE_PERIODS_US;
+
 /* Tag for verbosity control in main files */
 static const char* ADS_TAG = "ADS1115";
 
@@ -73,7 +78,7 @@ static bool validate_parameters(const i2c_master_dev_handle_t* device_handle,
     }
 
     /* Data pointer validation only if provided */
-    if ((data != NULL) && (*(void**)data == NULL)) {
+    if ((data != NULL) && (*(void* const*)data == NULL)) {
         ESP_LOGE(ADS_TAG, "Data output pointer is NULL");
         return false;
     }
@@ -81,6 +86,37 @@ static bool validate_parameters(const i2c_master_dev_handle_t* device_handle,
     return true;
 }
 
+/**
+ * @brief Validate every configuration field against its register bit field
+ *
+ * CERT-C INT31-C: Enumerators are OR-ed into the config word, so a value
+ * outside its field would corrupt the neighbouring settings
+ *
+ * @param config Configuration structure
+ * @return true if every field holds a defined setting, false otherwise
+ */
+static bool validate_config(const ads1115_config_t* config)
+{
+    bool valid = (((uint32_t)config->input_mux & ~0x7000U) == 0U) &&
+        (((uint32_t)config->pga & ~0x0E00U) == 0U) &&
+        ((uint32_t)config->pga <= (uint32_t)ADS1115_PGA_0_256V) &&
+        ((config->mode == ADS1115_MODE_CONTINUOUS) || (config->mode == ADS1115_MODE_SINGLE)) &&
+        (((uint32_t)config->data_rate & ~0x00E0U) == 0U) &&
+        ((config->comp_mode == ADS1115_COMP_MODE_TRADITIONAL) || (config->comp_mode == ADS1115_COMP_MODE_WINDOW)) &&
+        ((config->comp_polarity == ADS1115_COMP_POL_LOW) || (config->comp_polarity == ADS1115_COMP_POL_HIGH)) &&
+        ((config->comp_latch == ADS1115_COMP_LAT_DISABLED) || (config->comp_latch == ADS1115_COMP_LAT_ENABLED)) &&
+        ((uint32_t)config->comp_queue <= (uint32_t)ADS1115_COMP_QUEUE_DISABLE) &&
+        ((config->data_format == ADS1115_DATA_RAW) || (config->data_format == ADS1115_DATA_VOLTAGE));
+
+    if (!valid) {
+        ESP_LOGE(ADS_TAG, "Invalid configuration (mux 0x%x, pga 0x%x, mode 0x%x, rate 0x%x)",
+            (unsigned int)config->input_mux, (unsigned int)config->pga,
+            (unsigned int)config->mode, (unsigned int)config->data_rate);
+    }
+
+    return valid;
+}
+
 /**
  * @brief Convert raw ADC value to appropriate output format
  *
@@ -98,201 +134,1302 @@ static float convert_adc_value(int16_t raw_value, const ads1115_config_t* config
     }
 }
 
-esp_err_t ads1115_init_default_config(ads1115_config_t* config)
+/**
+ * @brief Build the 16-bit configuration register word
+ *
+ * CERT-C EXP45-C: Proper parentheses
+ *
+ * @param config Configuration structure
+ * @param mode Operating mode to encode (overrides config->mode)
+ * @return Configuration word with the OS bit set
+ */
+static uint16_t build_config_word(const ads1115_config_t* config, ads1115_mode_t mode)
 {
-    /* CERT-C EXP34-C: Validate pointer */
-    if (config == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
+    return (uint16_t)(ADS1115_OS_START_SINGLE |
+        config->input_mux |
+        config->pga |
+        mode |
+        config->data_rate |
+        config->comp_mode |
+        config->comp_polarity |
+        config->comp_latch |
+        config->comp_queue);
+}
 
-    /* Initialize with safe defaults */
-    memset(config, 0, sizeof(ads1115_config_t));
+/**
+ * @brief Wrap a bare device handle in a handle with no known register state
+ *
+ * Used by the handle-less API so all paths share one register layer.
+ *
+ * @param handle Handle to initialize
+ * @param device I2C device handle
+ */
+static void wrap_device(ads1115_handle_t* handle, i2c_master_dev_handle_t device)
+{
+    memset(handle, 0, sizeof(ads1115_handle_t));
+    handle->device = device;
+}
 
-    config->input_mux = ADS1115_MUX_AIN0_GND;
-    config->pga = ADS1115_PGA_2_048V;
-    config->mode = ADS1115_MODE_SINGLE;
-    config->data_rate = ADS1115_DR_128_SPS;
-    config->comp_mode = ADS1115_COMP_MODE_TRADITIONAL;
-    config->comp_polarity = ADS1115_COMP_POL_LOW;
-    config->comp_latch = ADS1115_COMP_LAT_DISABLED;
-    config->comp_queue = ADS1115_COMP_QUEUE_DISABLE;
-    config->data_format = ADS1115_DATA_VOLTAGE;
-    config->voltage_scale = get_voltage_scale(config->pga);
+/**
+ * @brief Record an issued transfer
+ *
+ * @param handle Device handle
+ * @param wire_bytes Bytes on the bus including address bytes
+ */
+static void count_transfer(ads1115_handle_t* handle, uint32_t wire_bytes)
+{
+    handle->stats.transactions++;
+    handle->stats.bytes += wire_bytes;
+}
 
-    return ESP_OK;
+/**
+ * @brief Record a transfer (or part of one) avoided by the shadow registers
+ *
+ * @param handle Device handle
+ * @param transactions Transactions avoided
+ * @param wire_bytes Bytes avoided including address bytes
+ */
+static void count_saved(ads1115_handle_t* handle, uint32_t transactions, uint32_t wire_bytes)
+{
+    handle->stats.transactions_saved += transactions;
+    handle->stats.bytes_saved += wire_bytes;
 }
 
-esp_err_t ads1115_configure(i2c_master_dev_handle_t* device_handle,
-    ads1115_config_t* config)
+/**
+ * @brief Write a 16-bit register and update the shadow copies
+ *
+ * Any bus error invalidates all shadows, as the device state is unknown.
+ *
+ * @param handle Device handle
+ * @param reg Register address
+ * @param value Value to write (MSB first on the bus)
+ * @return ESP_OK on success, I2C error code otherwise
+ */
+static esp_err_t write_register(ads1115_handle_t* handle, ads1115_register_t reg, uint16_t value)
 {
-    /* CERT-C EXP34-C: Parameter validation */
-    if (!validate_parameters(device_handle, config, NULL)) {
-        return ESP_ERR_INVALID_ARG;
+    uint8_t write_buffer[3] = {
+        (uint8_t)reg,
+        (uint8_t)(value >> 8U),
+        (uint8_t)(value & 0xFFU)
+    };
+
+    esp_err_t ret = i2c_master_transmit(handle->device,
+        write_buffer, sizeof(write_buffer),
+        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+
+    count_transfer(handle, 1U + sizeof(write_buffer));
+
+    if (ret != ESP_OK) {
+        handle->valid = 0U;
+        return ret;
+    }
+
+    handle->pointer = (uint8_t)reg;
+    handle->valid |= ADS1115_SHADOW_POINTER;
+
+    switch (reg) {
+    case ADS1115_REG_CONFIG:
+        /* OS is a write-only trigger; the shadow holds the persistent bits */
+        handle->config_reg = (uint16_t)(value & (uint16_t)~ADS1115_OS_START_SINGLE);
+        handle->valid |= ADS1115_SHADOW_CONFIG;
+        break;
+
+    case ADS1115_REG_LOW_THRESH:
+        handle->lo_thresh = value;
+        handle->valid |= ADS1115_SHADOW_LO_THRESH;
+        break;
+
+    case ADS1115_REG_HIGH_THRESH:
+        handle->hi_thresh = value;
+        handle->valid |= ADS1115_SHADOW_HI_THRESH;
+        break;
+
+    default:
+        break;
     }
 
+    return ESP_OK;
+}
+
+/**
+ * @brief Read a 16-bit register
+ *
+ * Skips the pointer write when the address pointer is known to already
+ * select the register, turning the transfer into a bare 2-byte read.
+ *
+ * @param handle Device handle
+ * @param reg Register address
+ * @param value Output for the register value
+ * @return ESP_OK on success, I2C error code otherwise
+ */
+static esp_err_t read_register(ads1115_handle_t* handle, ads1115_register_t reg, uint16_t* value)
+{
     esp_err_t ret;
-    uint8_t reg_addr = ADS1115_REG_CONFIG;
+    uint8_t reg_addr = (uint8_t)reg;
     uint8_t read_buffer[ADS1115_REGISTER_SIZE_BYTES] = { 0 };
 
-    /* Read current configuration for verification */
-    ret = i2c_master_transmit_receive(*device_handle,
-        &reg_addr, sizeof(reg_addr),
-        read_buffer, sizeof(read_buffer),
-        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+    if (((handle->valid & ADS1115_SHADOW_POINTER) != 0U) && (handle->pointer == reg_addr)) {
+        ret = i2c_master_receive(handle->device,
+            read_buffer, sizeof(read_buffer),
+            pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+
+        count_transfer(handle, 1U + sizeof(read_buffer));
+        count_saved(handle, 0U, 1U + sizeof(reg_addr));
+    }
+    else {
+        ret = i2c_master_transmit_receive(handle->device,
+            &reg_addr, sizeof(reg_addr),
+            read_buffer, sizeof(read_buffer),
+            pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+
+        count_transfer(handle, 1U + sizeof(reg_addr) + 1U + sizeof(read_buffer));
+    }
 
-    /* CERT-C ERR33-C: Check return values */
     if (ret != ESP_OK) {
-        ESP_LOGE(ADS_TAG, "Failed to read config register: %s", esp_err_to_name(ret));
+        handle->valid = 0U;
         return ret;
     }
 
-    ESP_LOGV(ADS_TAG, "Current config: 0x%04X",
-        (unsigned int)((read_buffer[0] << 8U) | read_buffer[1]));
-
-    /* Build new configuration word - CERT-C EXP45-C: Proper parentheses */
-    uint16_t config_word = (uint16_t)(ADS1115_OS_START_SINGLE |
-        config->input_mux |
-        config->pga |
-        config->mode);
+    handle->pointer = reg_addr;
+    handle->valid |= ADS1115_SHADOW_POINTER;
 
-    uint16_t config_word_low = (uint16_t)(config->data_rate |
-        config->comp_mode |
-        config->comp_polarity |
-        config->comp_latch |
-        config->comp_queue);
+    /* CERT-C INT31-C: Safe bit operations with proper casting */
+    *value = (uint16_t)((uint16_t)(read_buffer[0] << 8U) | (uint16_t)read_buffer[1]);
 
-    /* Prepare write buffer */
-    uint8_t write_buffer[3] = {
-        ADS1115_REG_CONFIG,
-        (uint8_t)(config_word >> 8U),
-        (uint8_t)(config_word_low & 0xFFU)
-    };
+    return ESP_OK;
+}
 
-    /* Write configuration */
-    ret = i2c_master_transmit(*device_handle,
-        write_buffer, sizeof(write_buffer),
-        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+/**
+ * @brief Read the conversion register
+ *
+ * @param handle Device handle
+ * @param raw_value Output for the signed conversion result
+ * @return ESP_OK on success, I2C error code otherwise
+ */
+static esp_err_t read_conversion(ads1115_handle_t* handle, int16_t* raw_value)
+{
+    uint16_t value = 0U;
 
+    esp_err_t ret = read_register(handle, ADS1115_REG_CONVERSION, &value);
     if (ret != ESP_OK) {
-        ESP_LOGE(ADS_TAG, "Failed to write config register: %s", esp_err_to_name(ret));
         return ret;
     }
 
-    /* Update voltage scale factor */
-    config->voltage_scale = get_voltage_scale(config->pga);
-
-    ESP_LOGD(ADS_TAG, "ADS1115 configured successfully. Scale factor: %e V/LSB",
-        (double)config->voltage_scale);
+    *raw_value = (int16_t)value;
 
     return ESP_OK;
 }
 
-esp_err_t ads1115_read_continuous(i2c_master_dev_handle_t* device_handle,
-    const ads1115_config_t* config,
-    float* data)
+/**
+ * @brief One-shot wait timer callback
+ *
+ * @param arg Binary semaphore the waiting task blocks on
+ */
+static void delay_timer_callback(void* arg)
 {
-    /* CERT-C EXP34-C: Parameter validation */
-    if (!validate_parameters(device_handle, config, &data)) {
-        return ESP_ERR_INVALID_ARG;
+    (void)xSemaphoreGive((SemaphoreHandle_t)arg);
+}
+
+/**
+ * @brief Poll the OS bit until the device reports not busy
+ *
+ * The address pointer is left at the config register by the start write,
+ * so each poll is a bare 2-byte read without a pointer write.
+ *
+ * @param handle Device handle
+ * @param data_rate Data rate of the running conversion
+ * @return ESP_OK when complete, ESP_ERR_TIMEOUT or I2C error code otherwise
+ */
+static esp_err_t poll_conversion_ready(ads1115_handle_t* handle, ads1115_data_rate_t data_rate)
+{
+    uint32_t poll_us = ads1115_get_conversion_time_us(data_rate) / 8U;
+    uint16_t config_reg = 0U;
+
+    if (poll_us < ADS1115_OS_POLL_MIN_US) {
+        poll_us = ADS1115_OS_POLL_MIN_US;
     }
 
-    esp_err_t ret;
-    uint8_t reg_addr = ADS1115_REG_CONVERSION;
-    uint8_t read_buffer[ADS1115_REGISTER_SIZE_BYTES] = { 0 };
+    for (uint32_t poll = 0U; poll < ADS1115_OS_POLL_MAX_COUNT; poll++) {
+        esp_err_t ret = read_register(handle, ADS1115_REG_CONFIG, &config_reg);
 
-    /* Read conversion register */
-    ret = i2c_master_transmit_receive(*device_handle,
-        &reg_addr, sizeof(reg_addr),
-        read_buffer, sizeof(read_buffer),
-        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+        if (ret != ESP_OK) {
+            ESP_LOGE(ADS_TAG, "Failed to poll OS bit: %s", esp_err_to_name(ret));
+            return ret;
+        }
 
-    /* CERT-C ERR33-C: Check return values */
-    if (ret != ESP_OK) {
-        ESP_LOGE(ADS_TAG, "Failed to read conversion register: %s", esp_err_to_name(ret));
-        return ret;
+        if ((config_reg & (uint16_t)ADS1115_OS_NOT_BUSY) != 0U) {
+            return ESP_OK;
+        }
+
+        ads1115_delay_us(poll_us);
     }
 
-    /* CERT-C INT31-C: Safe bit operations with proper casting */
-    int16_t raw_value = (int16_t)((uint16_t)(read_buffer[0] << 8U) |
-        (uint16_t)read_buffer[1]);
+    ESP_LOGE(ADS_TAG, "Conversion did not complete");
+    return ESP_ERR_TIMEOUT;
+}
 
-    /* Convert to requested format */
-    *data = convert_adc_value(raw_value, config);
+/**
+ * @brief ALERT/RDY falling-edge ISR
+ *
+ * Notifies the task blocked in ads1115_read_single_shot_rdy(), if any.
+ *
+ * @param arg Conversion-ready context
+ */
+static void IRAM_ATTR rdy_isr_handler(void* arg)
+{
+    ads1115_rdy_t* rdy = (ads1115_rdy_t*)arg;
+    TaskHandle_t task = rdy->waiting_task;
+    BaseType_t higher_priority_task_woken = pdFALSE;
 
-    ESP_LOGV(ADS_TAG, "Continuous read - Raw: %d, Output: %f %s",
-        raw_value, (double)*data,
-        (config->data_format == ADS1115_DATA_VOLTAGE) ? "V" : "counts");
+    if (task != NULL) {
+        vTaskNotifyGiveFromISR(task, &higher_priority_task_woken);
+    }
 
-    return ESP_OK;
+    portYIELD_FROM_ISR(higher_priority_task_woken);
 }
 
-esp_err_t ads1115_read_single_shot(i2c_master_dev_handle_t* device_handle,
-    const ads1115_config_t* config,
-    float* data)
+/**
+ * @brief Register the calling task for the next ALERT/RDY notification
+ *
+ * @param rdy Enabled conversion-ready context
+ */
+static void arm_rdy(ads1115_rdy_t* rdy)
 {
-    /* CERT-C EXP34-C: Parameter validation */
-    if (!validate_parameters(device_handle, config, &data)) {
-        return ESP_ERR_INVALID_ARG;
+    /* Discard stale notifications before arming */
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+    rdy->waiting_task = xTaskGetCurrentTaskHandle();
+}
+
+/**
+ * @brief Block on the ALERT/RDY notification of a started conversion
+ *
+ * Allows twice the conversion time (at least one tick) so a missed edge
+ * falls back to OS polling instead of hanging.
+ *
+ * @param rdy Armed conversion-ready context
+ * @param conversion_us Worst-case conversion time
+ * @return true if the conversion-ready pulse arrived, false on timeout
+ */
+static bool wait_rdy(ads1115_rdy_t* rdy, uint32_t conversion_us)
+{
+    TickType_t timeout_ticks = pdMS_TO_TICKS((2U * conversion_us) / 1000U) + 1U;
+    uint32_t notified = ulTaskNotifyTake(pdTRUE, timeout_ticks);
+
+    rdy->waiting_task = NULL;
+
+    if (notified == 0U) {
+        ESP_LOGW(ADS_TAG, "ALERT/RDY timeout, polling OS bit");
+        return false;
     }
 
-    esp_err_t ret;
+    return true;
+}
 
-    /* Build configuration for single-shot conversion */
-    uint16_t config_word = (uint16_t)(ADS1115_OS_START_SINGLE |
-        config->input_mux |
-        config->pga |
-        ADS1115_MODE_SINGLE);
+/**
+ * @brief Start a single-shot conversion without waiting for it
+ *
+ * With an enabled conversion-ready context the comparator fields are forced
+ * to RDY signalling and the calling task is armed for the ALERT/RDY
+ * notification before the write.
+ *
+ * @param handle Device handle
+ * @param config Conversion settings (mode is forced to single-shot)
+ * @param rdy Conversion-ready context, or NULL
+ * @param timestamp_us Output for the conversion start time
+ * @return ESP_OK on success, I2C error code otherwise
+ */
+static esp_err_t start_conversion(ads1115_handle_t* handle,
+    const ads1115_config_t* config,
+    ads1115_rdy_t* rdy,
+    int64_t* timestamp_us)
+{
+    bool use_rdy = (rdy != NULL) && rdy->enabled;
+    ads1115_config_t start_config = *config;
 
-    uint16_t config_word_low = (uint16_t)(config->data_rate |
-        config->comp_mode |
-        config->comp_polarity |
-        config->comp_latch |
-        config->comp_queue);
+    if (use_rdy) {
+        /* Conversion-ready signalling requires an enabled, non-latching, active-low comparator */
+        start_config.comp_mode = ADS1115_COMP_MODE_TRADITIONAL;
+        start_config.comp_polarity = ADS1115_COMP_POL_LOW;
+        start_config.comp_latch = ADS1115_COMP_LAT_DISABLED;
+        start_config.comp_queue = ADS1115_COMP_QUEUE_1;
+
+        arm_rdy(rdy);
+    }
 
     /* Write single-shot configuration */
-    uint8_t write_buffer[3] = {
-        ADS1115_REG_CONFIG,
-        (uint8_t)(config_word >> 8U),
-        (uint8_t)(config_word_low & 0xFFU)
-    };
+    esp_err_t ret = write_register(handle, ADS1115_REG_CONFIG,
+        build_config_word(&start_config, ADS1115_MODE_SINGLE));
 
-    ret = i2c_master_transmit(*device_handle,
-        write_buffer, sizeof(write_buffer),
-        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+    *timestamp_us = esp_timer_get_time();
 
     if (ret != ESP_OK) {
+        if (use_rdy) {
+            rdy->waiting_task = NULL;
+        }
         ESP_LOGE(ADS_TAG, "Failed to start single-shot conversion: %s",
             esp_err_to_name(ret));
-        return ret;
     }
 
-    /* Wait for conversion completion */
-    vTaskDelay(pdMS_TO_TICKS(ADS1115_CONVERSION_DELAY_MS));
+    return ret;
+}
 
-    /* Read conversion result */
-    uint8_t reg_addr = ADS1115_REG_CONVERSION;
-    uint8_t read_buffer[ADS1115_REGISTER_SIZE_BYTES] = { 0 };
+/**
+ * @brief Wait for a conversion started by start_conversion()
+ *
+ * Blocks on the ALERT/RDY notification when the context is enabled,
+ * falling back to OS polling after twice the conversion time. Otherwise
+ * sleeps until the data-rate derived conversion time has passed since the
+ * start, then confirms completion through the OS bit.
+ *
+ * @param handle Device handle
+ * @param data_rate Data rate of the running conversion
+ * @param rdy Conversion-ready context passed to start_conversion(), or NULL
+ * @param start_us Conversion start time
+ * @return ESP_OK when complete, ESP_ERR_TIMEOUT or I2C error code otherwise
+ */
+static esp_err_t wait_conversion(ads1115_handle_t* handle,
+    ads1115_data_rate_t data_rate,
+    ads1115_rdy_t* rdy,
+    int64_t start_us)
+{
+    uint32_t conversion_us = ads1115_get_conversion_time_us(data_rate);
 
-    ret = i2c_master_transmit_receive(*device_handle,
-        &reg_addr, sizeof(reg_addr),
-        read_buffer, sizeof(read_buffer),
-        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+    if ((rdy != NULL) && rdy->enabled) {
+        if (wait_rdy(rdy, conversion_us)) {
+            return ESP_OK;
+        }
+    }
+    else {
+        int64_t remaining_us = (start_us + (int64_t)conversion_us) - esp_timer_get_time();
+
+        if (remaining_us > 0) {
+            ads1115_delay_us((uint32_t)remaining_us);
+        }
+    }
+
+    return poll_conversion_ready(handle, data_rate);
+}
+
+/**
+ * @brief Start a single-shot conversion, wait for it and read the result
+ *
+ * @param handle Device handle
+ * @param config Conversion settings (mode is forced to single-shot)
+ * @param rdy Conversion-ready context, or NULL
+ * @param raw_value Output for the signed conversion result
+ * @param timestamp_us Output for the conversion start time, or NULL
+ * @return ESP_OK on success, ESP_ERR_TIMEOUT or I2C error code otherwise
+ */
+static esp_err_t run_single_conversion(ads1115_handle_t* handle,
+    const ads1115_config_t* config,
+    ads1115_rdy_t* rdy,
+    int16_t* raw_value,
+    int64_t* timestamp_us)
+{
+    int64_t start_us = 0;
+
+    esp_err_t ret = start_conversion(handle, config, rdy, &start_us);
+
+    if (timestamp_us != NULL) {
+        *timestamp_us = start_us;
+    }
+
+    if (ret == ESP_OK) {
+        ret = wait_conversion(handle, config->data_rate, rdy, start_us);
+    }
+
+    if (ret != ESP_OK) {
+        return ret;
+    }
 
+    /* Read conversion result */
+    ret = read_conversion(handle, raw_value);
     if (ret != ESP_OK) {
         ESP_LOGE(ADS_TAG, "Failed to read conversion result: %s", esp_err_to_name(ret));
         return ret;
     }
 
-    /* CERT-C INT31-C: Safe bit operations */
-    int16_t raw_value = (int16_t)((uint16_t)(read_buffer[0] << 8U) |
-        (uint16_t)read_buffer[1]);
+    return ESP_OK;
+}
 
-    /* Convert to requested format */
-    *data = convert_adc_value(raw_value, config);
+esp_err_t ads1115_init_default_config(ads1115_config_t* config)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
 
-    ESP_LOGV(ADS_TAG, "Single-shot read - Raw: %d, Output: %f %s",
-        raw_value, (double)*data,
-        (config->data_format == ADS1115_DATA_VOLTAGE) ? "V" : "counts");
+    /* Initialize with safe defaults */
+    memset(config, 0, sizeof(ads1115_config_t));
 
-    return ESP_OK;
-}
\ No newline at end of file
+    config->input_mux = ADS1115_MUX_AIN0_GND;
+    config->pga = ADS1115_PGA_2_048V;
+    config->mode = ADS1115_MODE_SINGLE;
+    config->data_rate = ADS1115_DR_128_SPS;
+    config->comp_mode = ADS1115_COMP_MODE_TRADITIONAL;
+    config->comp_polarity = ADS1115_COMP_POL_LOW;
+    config->comp_latch = ADS1115_COMP_LAT_DISABLED;
+    config->comp_queue = ADS1115_COMP_QUEUE_DISABLE;
+    config->data_format = ADS1115_DATA_VOLTAGE;
+    config->voltage_scale = get_voltage_scale(config->pga);
+
+    return ESP_OK;
+}
+
+uint32_t ads1115_get_data_rate_period_us(ads1115_data_rate_t data_rate)
+{
+    /* CERT-C INT31-C: Validate shift operations */
+    uint32_t rate_index = ((uint32_t)data_rate >> 5U) & 0x07U; /* Extract bits 7:5 */
+
+    return DATA_RATE_PERIODS_US[rate_index];
+}
+
+uint32_t ads1115_get_conversion_time_us(ads1115_data_rate_t data_rate)
+{
+    uint32_t period_us = ads1115_get_data_rate_period_us(data_rate);
+
+    return period_us + ((period_us * ADS1115_CONVERSION_MARGIN_PCT) / 100U);
+}
+
+void ads1115_delay_us(uint32_t duration_us)
+{
+    const uint32_t tick_us = (uint32_t)portTICK_PERIOD_MS * 1000U;
+
+    if (duration_us == 0U) {
+        return;
+    }
+
+    if (duration_us >= tick_us) {
+        vTaskDelay((TickType_t)((duration_us + tick_us - 1U) / tick_us));
+        return;
+    }
+
+    StaticSemaphore_t done_buffer;
+    SemaphoreHandle_t done = xSemaphoreCreateBinaryStatic(&done_buffer);
+    esp_timer_handle_t timer = NULL;
+    esp_timer_create_args_t timer_args = {
+        .callback = delay_timer_callback,
+        .arg = done,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "ads1115_delay"
+    };
+
+    if ((esp_timer_create(&timer_args, &timer) == ESP_OK) &&
+        (esp_timer_start_once(timer, duration_us) == ESP_OK)) {
+        /* A one-shot timer always fires, and the semaphore lives on this stack */
+        (void)xSemaphoreTake(done, portMAX_DELAY);
+    }
+    else {
+        /* Without a timer, give up the CPU for a whole tick rather than spin */
+        vTaskDelay(1);
+    }
+
+    if (timer != NULL) {
+        (void)esp_timer_delete(timer);
+    }
+}
+
+float ads1115_get_pga_voltage_scale(ads1115_pga_t pga)
+{
+    return get_voltage_scale(pga);
+}
+
+esp_err_t ads1115_configure(i2c_master_dev_handle_t* device_handle,
+    ads1115_config_t* config)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if (!validate_parameters(device_handle, config, NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret;
+    ads1115_handle_t handle;
+
+    wrap_device(&handle, *device_handle);
+
+    /* The read-back only feeds a verbose log, so skip it unless it is shown */
+    if (esp_log_level_get(ADS_TAG) >= ESP_LOG_VERBOSE) {
+        uint16_t current = 0U;
+
+        ret = read_register(&handle, ADS1115_REG_CONFIG, &current);
+
+        /* CERT-C ERR33-C: Check return values */
+        if (ret != ESP_OK) {
+            ESP_LOGE(ADS_TAG, "Failed to read config register: %s", esp_err_to_name(ret));
+            return ret;
+        }
+
+        ESP_LOGV(ADS_TAG, "Current config: 0x%04X", (unsigned int)current);
+    }
+
+    /* Write configuration */
+    ret = write_register(&handle, ADS1115_REG_CONFIG,
+        build_config_word(config, config->mode));
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to write config register: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    /* Update voltage scale factor */
+    config->voltage_scale = get_voltage_scale(config->pga);
+
+    ESP_LOGD(ADS_TAG, "ADS1115 configured successfully. Scale factor: %e V/LSB",
+        (double)config->voltage_scale);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_read_continuous(i2c_master_dev_handle_t* device_handle,
+    const ads1115_config_t* config,
+    float* data)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if (!validate_parameters(device_handle, config, &data)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int16_t raw_value = 0;
+    ads1115_handle_t handle;
+
+    wrap_device(&handle, *device_handle);
+
+    /* Read conversion register */
+    esp_err_t ret = read_conversion(&handle, &raw_value);
+
+    /* CERT-C ERR33-C: Check return values */
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to read conversion register: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    /* Convert to requested format */
+    *data = convert_adc_value(raw_value, config);
+
+    ESP_LOGV(ADS_TAG, "Continuous read - Raw: %d, Output: %f %s",
+        raw_value, (double)*data,
+        (config->data_format == ADS1115_DATA_VOLTAGE) ? "V" : "counts");
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_read_single_shot(i2c_master_dev_handle_t* device_handle,
+    const ads1115_config_t* config,
+    float* data)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if (!validate_parameters(device_handle, config, &data)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int16_t raw_value = 0;
+    ads1115_handle_t handle;
+
+    wrap_device(&handle, *device_handle);
+
+    /* Start, wait for and read a single-shot conversion */
+    esp_err_t ret = run_single_conversion(&handle, config, NULL, &raw_value, NULL);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    /* Convert to requested format */
+    *data = convert_adc_value(raw_value, config);
+
+    ESP_LOGV(ADS_TAG, "Single-shot read - Raw: %d, Output: %f %s",
+        raw_value, (double)*data,
+        (config->data_format == ADS1115_DATA_VOLTAGE) ? "V" : "counts");
+
+    return ESP_OK;
+}
+
+bool ads1115_is_saturated(int16_t raw)
+{
+    return (raw >= ADS1115_MAX_ADC_VALUE) || (raw < ADS1115_MIN_ADC_VALUE);
+}
+
+esp_err_t ads1115_read_raw(i2c_master_dev_handle_t* device_handle,
+    const ads1115_config_t* config,
+    int16_t* raw)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if (!validate_parameters(device_handle, config, &raw)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret;
+    ads1115_handle_t handle;
+
+    wrap_device(&handle, *device_handle);
+
+    if (config->mode == ADS1115_MODE_CONTINUOUS) {
+        ret = read_conversion(&handle, raw);
+        if (ret != ESP_OK) {
+            ESP_LOGE(ADS_TAG, "Failed to read conversion register: %s", esp_err_to_name(ret));
+        }
+    }
+    else {
+        ret = run_single_conversion(&handle, config, NULL, raw, NULL);
+    }
+
+    return ret;
+}
+
+esp_err_t ads1115_read_raw_block(i2c_master_dev_handle_t* device_handle,
+    const ads1115_config_t* config,
+    int16_t* samples,
+    size_t count)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if (!validate_parameters(device_handle, config, &samples)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    ads1115_handle_t handle;
+
+    wrap_device(&handle, *device_handle);
+
+    if (config->mode != ADS1115_MODE_CONTINUOUS) {
+        for (size_t i = 0U; (i < count) && (ret == ESP_OK); i++) {
+            ret = run_single_conversion(&handle, config, NULL, &samples[i], NULL);
+        }
+        return ret;
+    }
+
+    /* The first read sets the pointer; every further sample is a bare 2-byte read */
+    uint32_t conversion_us = ads1115_get_conversion_time_us(config->data_rate);
+
+    for (size_t i = 0U; (i < count) && (ret == ESP_OK); i++) {
+        /* Pace at the worst-case conversion time so no result is read twice */
+        if (i > 0U) {
+            ads1115_delay_us(conversion_us);
+        }
+
+        ret = read_conversion(&handle, &samples[i]);
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to read sample block: %s", esp_err_to_name(ret));
+    }
+
+    return ret;
+}
+
+esp_err_t ads1115_rdy_enable(i2c_master_dev_handle_t* device_handle,
+    ads1115_rdy_t* rdy,
+    gpio_num_t alert_io)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if (!validate_parameters(device_handle, rdy, NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!GPIO_IS_VALID_GPIO(alert_io)) {
+        ESP_LOGE(ADS_TAG, "Invalid ALERT/RDY GPIO %d", (int)alert_io);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret;
+    ads1115_handle_t handle;
+
+    wrap_device(&handle, *device_handle);
+
+    /* Hi_thresh MSB = 1 and Lo_thresh MSB = 0 select conversion-ready mode */
+    ret = write_register(&handle, ADS1115_REG_LOW_THRESH, ADS1115_RDY_LO_THRESH);
+    if (ret == ESP_OK) {
+        ret = write_register(&handle, ADS1115_REG_HIGH_THRESH, ADS1115_RDY_HI_THRESH);
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to write threshold registers: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    /* ALERT/RDY is open-drain and asserts low at the end of a conversion */
+    gpio_config_t io_config = {
+        .pin_bit_mask = (1ULL << (uint32_t)alert_io),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_NEGEDGE
+    };
+
+    ret = gpio_config(&io_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to configure ALERT/RDY GPIO: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    /* ESP_ERR_INVALID_STATE means the service is already installed */
+    ret = gpio_install_isr_service(0);
+    if ((ret != ESP_OK) && (ret != ESP_ERR_INVALID_STATE)) {
+        ESP_LOGE(ADS_TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    rdy->alert_io = alert_io;
+    rdy->waiting_task = NULL;
+
+    ret = gpio_isr_handler_add(alert_io, rdy_isr_handler, rdy);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to add ALERT/RDY ISR: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    rdy->enabled = true;
+
+    ESP_LOGD(ADS_TAG, "Conversion-ready mode enabled on GPIO %d", (int)alert_io);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_rdy_disable(ads1115_rdy_t* rdy)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (rdy == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!rdy->enabled) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t ret = gpio_isr_handler_remove(rdy->alert_io);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to remove ALERT/RDY ISR: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    rdy->enabled = false;
+    rdy->waiting_task = NULL;
+
+    return gpio_set_intr_type(rdy->alert_io, GPIO_INTR_DISABLE);
+}
+
+esp_err_t ads1115_read_single_shot_rdy(i2c_master_dev_handle_t* device_handle,
+    const ads1115_config_t* config,
+    ads1115_rdy_t* rdy,
+    float* data)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if (!validate_parameters(device_handle, config, &data)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int16_t raw_value = 0;
+    ads1115_handle_t handle;
+
+    wrap_device(&handle, *device_handle);
+
+    esp_err_t ret = run_single_conversion(&handle, config, rdy, &raw_value, NULL);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    *data = convert_adc_value(raw_value, config);
+
+    ESP_LOGV(ADS_TAG, "Single-shot (RDY) read - Raw: %d, Output: %f %s",
+        raw_value, (double)*data,
+        (config->data_format == ADS1115_DATA_VOLTAGE) ? "V" : "counts");
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Build the single-shot configuration for one scan list entry
+ *
+ * @param base Base configuration
+ * @param entry Scan list entry
+ * @param entry_config Output configuration
+ */
+static void apply_scan_entry(const ads1115_config_t* base,
+    const ads1115_scan_entry_t* entry,
+    ads1115_config_t* entry_config)
+{
+    *entry_config = *base;
+    entry_config->input_mux = entry->input_mux;
+    entry_config->pga = entry->pga;
+    entry_config->data_rate = entry->data_rate;
+    entry_config->mode = ADS1115_MODE_SINGLE;
+}
+
+esp_err_t ads1115_scan(i2c_master_dev_handle_t* device_handle,
+    const ads1115_config_t* config,
+    const ads1115_scan_entry_t* entries,
+    size_t entry_count,
+    ads1115_rdy_t* rdy,
+    ads1115_scan_result_t* results)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if (!validate_parameters(device_handle, config, NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if ((entries == NULL) || (results == NULL) || (entry_count == 0U)) {
+        ESP_LOGE(ADS_TAG, "Invalid scan list");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ads1115_config_t entry_config;
+    ads1115_config_t next_config;
+
+    /* Reject the whole list before the first write reaches the chip */
+    for (size_t i = 0U; i < entry_count; i++) {
+        apply_scan_entry(config, &entries[i], &entry_config);
+
+        if (!validate_config(&entry_config)) {
+            ESP_LOGE(ADS_TAG, "Invalid scan entry %u", (unsigned int)i);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    esp_err_t ret;
+    ads1115_handle_t handle;
+
+    wrap_device(&handle, *device_handle);
+
+    apply_scan_entry(config, &entries[0], &entry_config);
+    ret = start_conversion(&handle, &entry_config, rdy, &results[0].timestamp_us);
+
+    for (size_t i = 0U; (i < entry_count) && (ret == ESP_OK); i++) {
+        bool overlap = (i + 1U) < entry_count;
+
+        ret = wait_conversion(&handle, entry_config.data_rate, rdy, results[i].timestamp_us);
+        if (ret != ESP_OK) {
+            break;
+        }
+
+        /*
+         * Start the next entry before reading this one: the conversion
+         * register keeps this result until the next conversion completes,
+         * so the read runs while the next entry converts.
+         */
+        if (overlap) {
+            apply_scan_entry(config, &entries[i + 1U], &next_config);
+            ret = start_conversion(&handle, &next_config, rdy, &results[i + 1U].timestamp_us);
+            if (ret != ESP_OK) {
+                break;
+            }
+        }
+
+        ret = read_conversion(&handle, &results[i].raw);
+
+        /* Preempted past the shortest next conversion: the read may hold the next result */
+        if ((ret == ESP_OK) && overlap) {
+            uint32_t period_us = ads1115_get_data_rate_period_us(next_config.data_rate);
+            int64_t shortest_us = (int64_t)(period_us - ((period_us * ADS1115_CONVERSION_MARGIN_PCT) / 100U));
+
+            if ((esp_timer_get_time() - results[i + 1U].timestamp_us) >= shortest_us) {
+                ESP_LOGW(ADS_TAG, "Scan entry %u read late, converting it again", (unsigned int)i);
+
+                /* Let the next conversion finish, redo this entry without overlap, then restart the next */
+                ret = wait_conversion(&handle, next_config.data_rate, rdy, results[i + 1U].timestamp_us);
+                if (ret == ESP_OK) {
+                    ret = run_single_conversion(&handle, &entry_config, rdy,
+                        &results[i].raw, &results[i].timestamp_us);
+                }
+                if (ret == ESP_OK) {
+                    ret = start_conversion(&handle, &next_config, rdy, &results[i + 1U].timestamp_us);
+                }
+            }
+        }
+
+        if (ret != ESP_OK) {
+            break;
+        }
+
+        results[i].pga = entries[i].pga;
+        results[i].saturated = ads1115_is_saturated(results[i].raw);
+
+        if (overlap) {
+            entry_config = next_config;
+        }
+    }
+
+    if (ret != ESP_OK) {
+        if (rdy != NULL) {
+            rdy->waiting_task = NULL;
+        }
+        ESP_LOGE(ADS_TAG, "Scan aborted: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGV(ADS_TAG, "Scanned %u entries in %lld us", (unsigned int)entry_count,
+        (long long)(esp_timer_get_time() - results[0].timestamp_us));
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_handle_init(ads1115_handle_t* handle,
+    i2c_master_dev_handle_t device,
+    bool verify_writes)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (device == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    wrap_device(handle, device);
+    handle->verify_writes = verify_writes;
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_handle_invalidate(ads1115_handle_t* handle)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    handle->valid = 0U;
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_handle_configure(ads1115_handle_t* handle,
+    ads1115_config_t* config)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (handle->device == NULL) || (config == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Configure without starting a conversion */
+    uint16_t config_word = (uint16_t)(build_config_word(config, config->mode) &
+        (uint16_t)~ADS1115_OS_START_SINGLE);
+
+    config->voltage_scale = get_voltage_scale(config->pga);
+
+    /* Savings are counted against ads1115_configure(): one write plus one read-back */
+    if (((handle->valid & ADS1115_SHADOW_CONFIG) != 0U) && (handle->config_reg == config_word)) {
+        count_saved(handle, 2U, 4U + 5U);
+        return ESP_OK;
+    }
+
+    esp_err_t ret = write_register(handle, ADS1115_REG_CONFIG, config_word);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to write config register: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    if (!handle->verify_writes) {
+        count_saved(handle, 1U, 5U);
+        return ESP_OK;
+    }
+
+    uint16_t readback = 0U;
+
+    ret = read_register(handle, ADS1115_REG_CONFIG, &readback);
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to read back config register: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    /* OS reads back as the busy flag, not as written */
+    if ((uint16_t)(readback & (uint16_t)~ADS1115_OS_NOT_BUSY) != config_word) {
+        handle->valid &= (uint8_t)~ADS1115_SHADOW_CONFIG;
+        ESP_LOGE(ADS_TAG, "Config read-back mismatch: wrote 0x%04X, read 0x%04X",
+            (unsigned int)config_word, (unsigned int)readback);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_handle_write_thresholds(ads1115_handle_t* handle,
+    int16_t lo_thresh,
+    int16_t hi_thresh)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (handle->device == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    uint16_t lo_value = (uint16_t)lo_thresh;
+    uint16_t hi_value = (uint16_t)hi_thresh;
+
+    if (((handle->valid & ADS1115_SHADOW_LO_THRESH) != 0U) && (handle->lo_thresh == lo_value)) {
+        count_saved(handle, 1U, 4U);
+    }
+    else {
+        ret = write_register(handle, ADS1115_REG_LOW_THRESH, lo_value);
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to write Lo_thresh: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    if (((handle->valid & ADS1115_SHADOW_HI_THRESH) != 0U) && (handle->hi_thresh == hi_value)) {
+        count_saved(handle, 1U, 4U);
+    }
+    else {
+        ret = write_register(handle, ADS1115_REG_HIGH_THRESH, hi_value);
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to write Hi_thresh: %s", esp_err_to_name(ret));
+    }
+
+    return ret;
+}
+
+esp_err_t ads1115_handle_read_raw(ads1115_handle_t* handle,
+    const ads1115_config_t* config,
+    ads1115_rdy_t* rdy,
+    int16_t* raw)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (handle->device == NULL) || (config == NULL) || (raw == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (config->mode != ADS1115_MODE_CONTINUOUS) {
+        return run_single_conversion(handle, config, rdy, raw, NULL);
+    }
+
+    esp_err_t ret = ESP_OK;
+    bool use_rdy = (rdy != NULL) && rdy->enabled;
+    ads1115_config_t run_config = *config;
+
+    if (use_rdy) {
+        /* Same conversion-ready comparator fields as the single-shot path */
+        run_config.comp_mode = ADS1115_COMP_MODE_TRADITIONAL;
+        run_config.comp_polarity = ADS1115_COMP_POL_LOW;
+        run_config.comp_latch = ADS1115_COMP_LAT_DISABLED;
+        run_config.comp_queue = ADS1115_COMP_QUEUE_1;
+    }
+
+    uint16_t config_word = (uint16_t)(build_config_word(&run_config, ADS1115_MODE_CONTINUOUS) &
+        (uint16_t)~ADS1115_OS_START_SINGLE);
+
+    if (((handle->valid & ADS1115_SHADOW_CONFIG) != 0U) && (handle->config_reg == config_word)) {
+        count_saved(handle, 1U, 4U);
+    }
+    else {
+        if (use_rdy) {
+            arm_rdy(rdy);
+        }
+
+        ret = write_register(handle, ADS1115_REG_CONFIG, config_word);
+
+        int64_t start_us = esp_timer_get_time();
+        uint32_t conversion_us = ads1115_get_conversion_time_us(config->data_rate);
+
+        /*
+         * The conversion register still holds a result from the previous
+         * mux/PGA until the first conversion with the new settings completes
+         */
+        if ((ret == ESP_OK) && (!use_rdy || !wait_rdy(rdy, conversion_us))) {
+            int64_t remaining_us = (start_us + (int64_t)conversion_us) - esp_timer_get_time();
+
+            if (remaining_us > 0) {
+                ads1115_delay_us((uint32_t)remaining_us);
+            }
+        }
+        else if (use_rdy && (ret != ESP_OK)) {
+            rdy->waiting_task = NULL;
+        }
+    }
+
+    if (ret == ESP_OK) {
+        ret = read_conversion(handle, raw);
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to read conversion register: %s", esp_err_to_name(ret));
+    }
+
+    return ret;
+}
+
+esp_err_t ads1115_handle_start_single(ads1115_handle_t* handle,
+    const ads1115_config_t* config)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (handle->device == NULL) || (config == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = write_register(handle, ADS1115_REG_CONFIG,
+        build_config_word(config, ADS1115_MODE_SINGLE));
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to start conversion: %s", esp_err_to_name(ret));
+    }
+
+    return ret;
+}
+
+esp_err_t ads1115_handle_read_conversion(ads1115_handle_t* handle,
+    int16_t* raw)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (handle->device == NULL) || (raw == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = read_conversion(handle, raw);
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(ADS_TAG, "Failed to read conversion register: %s", esp_err_to_name(ret));
+    }
+
+    return ret;
+}
+
+esp_err_t ads1115_handle_get_stats(const ads1115_handle_t* handle,
+    ads1115_bus_stats_t* stats)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (stats == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *stats = handle->stats;
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_handle_reset_stats(ads1115_handle_t* handle)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (handle == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(&handle->stats, 0, sizeof(ads1115_bus_stats_t));
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_prepare(const ads1115_config_t* config,
+    ads1115_prepared_t* prepared)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((config == NULL) || (prepared == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* The fast path trusts the descriptor, so this is the only check */
+    if (!validate_config(config)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint16_t config_word = build_config_word(config, config->mode);
+    uint32_t conversion_us = ads1115_get_conversion_time_us(config->data_rate);
+    uint32_t poll_us = conversion_us / 8U;
+
+    memset(prepared, 0, sizeof(ads1115_prepared_t));
+
+    prepared->config_write[0] = (uint8_t)ADS1115_REG_CONFIG;
+    prepared->config_write[1] = (uint8_t)(config_word >> 8U);
+    prepared->config_write[2] = (uint8_t)(config_word & 0xFFU);
+    prepared->conversion_reg = (uint8_t)ADS1115_REG_CONVERSION;
+    prepared->single_shot = (config->mode == ADS1115_MODE_SINGLE);
+    prepared->conversion_us = conversion_us;
+    prepared->poll_us = (poll_us < ADS1115_OS_POLL_MIN_US) ? ADS1115_OS_POLL_MIN_US : poll_us;
+    prepared->pga = config->pga;
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Run a prepared descriptor, optionally completing on ALERT/RDY
+ *
+ * @param device I2C device handle
+ * @param prepared Descriptor from ads1115_prepare()
+ * @param rdy Conversion-ready context, or NULL to wait and poll the OS bit
+ * @param raw Output for the signed conversion result
+ * @return ESP_OK on success, ESP_ERR_TIMEOUT or I2C error code otherwise
+ */
+static esp_err_t execute_prepared(i2c_master_dev_handle_t device,
+    const ads1115_prepared_t* prepared,
+    ads1115_rdy_t* rdy,
+    int16_t* raw)
+{
+    esp_err_t ret;
+    uint8_t read_buffer[ADS1115_REGISTER_SIZE_BYTES];
+
+    if (prepared->single_shot) {
+        bool use_rdy = (rdy != NULL) && rdy->enabled;
+        uint8_t config_write[sizeof(prepared->config_write)] = {
+            prepared->config_write[0],
+            prepared->config_write[1],
+            prepared->config_write[2]
+        };
+
+        if (use_rdy) {
+            /* Traditional, active-low, non-latching, assert after one conversion: all comparator bits clear */
+            config_write[2] &= (uint8_t)~0x1FU;
+            arm_rdy(rdy);
+        }
+
+        ret = i2c_master_transmit(device, config_write, sizeof(config_write),
+            pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+        if (ret != ESP_OK) {
+            if (use_rdy) {
+                rdy->waiting_task = NULL;
+            }
+            return ret;
+        }
+
+        if (!use_rdy) {
+            ads1115_delay_us(prepared->conversion_us);
+        }
+
+        if (!use_rdy || !wait_rdy(rdy, prepared->conversion_us)) {
+            /* Pointer is at the config register: bare reads return the OS bit */
+            uint32_t poll = 0U;
+
+            for (;;) {
+                ret = i2c_master_receive(device, read_buffer, sizeof(read_buffer),
+                    pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+                if (ret != ESP_OK) {
+                    return ret;
+                }
+
+                if ((read_buffer[0] & (uint8_t)(ADS1115_OS_NOT_BUSY >> 8U)) != 0U) {
+                    break;
+                }
+
+                if (++poll >= ADS1115_OS_POLL_MAX_COUNT) {
+                    return ESP_ERR_TIMEOUT;
+                }
+
+                ads1115_delay_us(prepared->poll_us);
+            }
+        }
+    }
+
+    ret = i2c_master_transmit_receive(device,
+        &prepared->conversion_reg, sizeof(prepared->conversion_reg),
+        read_buffer, sizeof(read_buffer),
+        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    /* CERT-C INT31-C: Safe bit operations */
+    *raw = (int16_t)((uint16_t)(read_buffer[0] << 8U) | (uint16_t)read_buffer[1]);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_execute(i2c_master_dev_handle_t device,
+    const ads1115_prepared_t* prepared,
+    int16_t* raw)
+{
+    return execute_prepared(device, prepared, NULL, raw);
+}
+
+esp_err_t ads1115_execute_rdy(i2c_master_dev_handle_t device,
+    const ads1115_prepared_t* prepared,
+    ads1115_rdy_t* rdy,
+    int16_t* raw)
+{
+    return execute_prepared(device, prepared, rdy, raw);
+}
@@ -0,0 +1,218 @@
+/**
+ * @file ads1115_autorange.c
+ * @brief ADS1115 auto-ranging PGA implementation
+ *
+ * Range decisions are integer only: a result is projected into another
+ * range by the ratio of full-scale voltages in millivolts.
+ */
+
+#include "ads1115_autorange.h"
+
+/* Tag for verbosity control in main files */
+static const char* RANGE_TAG = "ADS1115_RANGE";
+
+/**
+ * @brief Full-scale voltage for each PGA setting in millivolts
+ *
+ * Indexed by PGA bits 11:9; codes 6 and 7 also select ±0.256V
+ */
+static const uint32_t PGA_FULL_SCALE_MV[] = {
+    6144U, 4096U, 2048U, 1024U, 512U, 256U, 256U, 256U
+};
+
+#define PGA_INDEX_MAX   (5U)    /**< Highest distinct gain (±0.256V) */
+
+/**
+ * @brief Gain index of a PGA setting (0 = widest range)
+ *
+ * @param pga PGA setting
+ * @return Index 0 to PGA_INDEX_MAX
+ */
+static uint32_t pga_index(ads1115_pga_t pga)
+{
+    /* CERT-C INT31-C: Validate shift operations */
+    uint32_t index = ((uint32_t)pga >> 9U) & 0x07U;
+
+    return (index > PGA_INDEX_MAX) ? PGA_INDEX_MAX : index;
+}
+
+/**
+ * @brief PGA setting for a gain index
+ *
+ * @param index Index 0 to PGA_INDEX_MAX
+ * @return PGA setting
+ */
+static ads1115_pga_t pga_from_index(uint32_t index)
+{
+    return (ads1115_pga_t)(index << 9U);
+}
+
+esp_err_t ads1115_autorange_init_default_config(ads1115_autorange_config_t* config)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    config->widest_pga = ADS1115_PGA_6_144V;
+    config->narrowest_pga = ADS1115_PGA_0_256V;
+    config->upshift_counts = ADS1115_AUTORANGE_UPSHIFT_COUNTS;
+    config->downshift_counts = ADS1115_AUTORANGE_DOWNSHIFT_COUNTS;
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_autorange_init(ads1115_autorange_t* state,
+    const ads1115_autorange_config_t* config,
+    ads1115_pga_t initial_pga)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((state == NULL) || (config == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t wide = pga_index(config->widest_pga);
+    uint32_t narrow = pga_index(config->narrowest_pga);
+    uint32_t initial = pga_index(initial_pga);
+
+    if ((wide > narrow) || (config->downshift_counts <= config->upshift_counts) ||
+        (config->downshift_counts > (uint16_t)ADS1115_MAX_ADC_VALUE)) {
+        ESP_LOGE(RANGE_TAG, "Invalid auto-range limits");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(state, 0, sizeof(ads1115_autorange_t));
+    state->config = *config;
+
+    if (initial < wide) {
+        initial = wide;
+    }
+    else if (initial > narrow) {
+        initial = narrow;
+    }
+
+    state->pga = pga_from_index(initial);
+
+    return ESP_OK;
+}
+
+ads1115_pga_t ads1115_autorange_update(ads1115_autorange_t* state,
+    int16_t raw,
+    ads1115_pga_t pga)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (state == NULL) {
+        return ADS1115_PGA_2_048V;
+    }
+
+    uint32_t wide = pga_index(state->config.widest_pga);
+    uint32_t narrow = pga_index(state->config.narrowest_pga);
+    uint32_t used = pga_index(pga);
+    uint32_t next = used;
+
+    if (ads1115_is_saturated(raw)) {
+        /* The true value is unknown; the widest range always recovers it */
+        state->saturations++;
+        next = wide;
+    }
+    else {
+        /* CERT-C INT32-C: |raw| <= 32767 and full scale <= 6144, no overflow */
+        uint32_t magnitude = (raw < 0) ? (uint32_t)(-(int32_t)raw) : (uint32_t)raw;
+        uint32_t projected = magnitude * PGA_FULL_SCALE_MV[used];
+        uint32_t best = wide;
+
+        /* Highest gain at which the value stays below the upshift level */
+        for (uint32_t index = narrow; index > wide; index--) {
+            if (projected < ((uint32_t)state->config.upshift_counts * PGA_FULL_SCALE_MV[index])) {
+                best = index;
+                break;
+            }
+        }
+
+        if ((magnitude > state->config.downshift_counts) || (best > used)) {
+            next = best;
+        }
+    }
+
+    /* Limits may have been narrowed since the sample was taken */
+    if (next < wide) {
+        next = wide;
+    }
+    else if (next > narrow) {
+        next = narrow;
+    }
+
+    if (next != pga_index(state->pga)) {
+        state->range_changes++;
+        ESP_LOGV(RANGE_TAG, "Range %lu mV -> %lu mV (raw %d)",
+            (unsigned long)PGA_FULL_SCALE_MV[pga_index(state->pga)],
+            (unsigned long)PGA_FULL_SCALE_MV[next], raw);
+    }
+
+    state->pga = pga_from_index(next);
+
+    return state->pga;
+}
+
+esp_err_t ads1115_autorange_read(ads1115_handle_t* handle,
+    const ads1115_config_t* config,
+    ads1115_autorange_t* state,
+    ads1115_rdy_t* rdy,
+    ads1115_scan_result_t* result)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (config == NULL) || (state == NULL) || (result == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ads1115_config_t sample_config = *config;
+
+    /* Single-shot so a range change never returns a result from the old range */
+    sample_config.pga = state->pga;
+    sample_config.mode = ADS1115_MODE_SINGLE;
+
+    result->timestamp_us = esp_timer_get_time();
+
+    esp_err_t ret = ads1115_handle_read_raw(handle, &sample_config, rdy, &result->raw);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    result->pga = sample_config.pga;
+    result->saturated = ads1115_is_saturated(result->raw);
+
+    (void)ads1115_autorange_update(state, result->raw, result->pga);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_autorange_scan(ads1115_handle_t* handle,
+    const ads1115_config_t* config,
+    const ads1115_scan_entry_t* entries,
+    size_t entry_count,
+    ads1115_autorange_t* states,
+    ads1115_rdy_t* rdy,
+    ads1115_scan_result_t* results)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (config == NULL) || (entries == NULL) ||
+        (states == NULL) || (results == NULL) || (entry_count == 0U)) {
+        ESP_LOGE(RANGE_TAG, "Invalid scan list");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ads1115_config_t entry_config = *config;
+
+    for (size_t i = 0U; i < entry_count; i++) {
+        entry_config.input_mux = entries[i].input_mux;
+        entry_config.data_rate = entries[i].data_rate;
+
+        esp_err_t ret = ads1115_autorange_read(handle, &entry_config, &states[i], rdy, &results[i]);
+        if (ret != ESP_OK) {
+            ESP_LOGE(RANGE_TAG, "Scan aborted at entry %u", (unsigned int)i);
+            return ret;
+        }
+    }
+
+    return ESP_OK;
+}
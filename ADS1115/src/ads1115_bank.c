@@ -0,0 +1,217 @@
+/**
+ * @file ads1115_bank.c
+ * @brief ADS1115 multi-chip bank implementation
+ *
+ * Conversions for one scan list entry run on all chips at once. Each chip
+ * is read and immediately restarted on the next entry, so the wait per
+ * entry shrinks by the bus time spent on the other chips.
+ */
+
+#include "ads1115_bank.h"
+
+/* Tag for verbosity control in main files */
+static const char* BANK_TAG = "ADS1115_BANK";
+
+/**
+ * @brief Wait until an esp_timer deadline
+ *
+ * Uses the single-device conversion wait, which yields the CPU for both
+ * whole ticks and sub-tick remainders.
+ *
+ * @param deadline_us esp_timer time to wait for
+ */
+static void wait_until_us(int64_t deadline_us)
+{
+    int64_t remaining_us = deadline_us - esp_timer_get_time();
+
+    if (remaining_us > 0) {
+        ads1115_delay_us((uint32_t)remaining_us);
+    }
+}
+
+/**
+ * @brief Build the configuration for one scan list entry
+ *
+ * @param base Base configuration
+ * @param entry Scan list entry
+ * @param entry_config Output configuration
+ */
+static void apply_entry(const ads1115_config_t* base,
+    const ads1115_scan_entry_t* entry,
+    ads1115_config_t* entry_config)
+{
+    *entry_config = *base;
+    entry_config->input_mux = entry->input_mux;
+    entry_config->pga = entry->pga;
+    entry_config->data_rate = entry->data_rate;
+    entry_config->mode = ADS1115_MODE_SINGLE;
+}
+
+esp_err_t ads1115_bank_init(ads1115_bank_t* bank,
+    const i2c_master_dev_handle_t* devices,
+    size_t chip_count)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((bank == NULL) || (devices == NULL) ||
+        (chip_count == 0U) || (chip_count > ADS1115_BANK_MAX_CHIPS)) {
+        ESP_LOGE(BANK_TAG, "Invalid bank parameters");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(bank, 0, sizeof(ads1115_bank_t));
+
+    for (size_t chip = 0U; chip < chip_count; chip++) {
+        esp_err_t ret = ads1115_handle_init(&bank->chips[chip], devices[chip], false);
+        if (ret != ESP_OK) {
+            ESP_LOGE(BANK_TAG, "Invalid device handle for chip %u", (unsigned int)chip);
+            return ret;
+        }
+    }
+
+    bank->chip_count = chip_count;
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_bank_read_frame(ads1115_bank_t* bank,
+    const ads1115_config_t* config,
+    const ads1115_scan_entry_t* entries,
+    size_t entry_count,
+    ads1115_bank_frame_t* frame)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((bank == NULL) || (config == NULL) || (entries == NULL) || (frame == NULL) ||
+        (bank->chip_count == 0U) ||
+        (entry_count == 0U) || (entry_count > ADS1115_BANK_MAX_INPUTS)) {
+        ESP_LOGE(BANK_TAG, "Invalid frame parameters");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_OK;
+    ads1115_config_t entry_config;
+    int64_t ready_us = 0;
+
+    frame->input_count = entry_count;
+    frame->channel_count = bank->chip_count * entry_count;
+
+    /*
+     * Round `input` starts entry `input` on every chip; from the second
+     * round on, each chip's previous result is read right before its next
+     * start. One extra round collects the last results.
+     */
+    for (size_t input = 0U; (input <= entry_count) && (ret == ESP_OK); input++) {
+        bool start = (input < entry_count);
+
+        if (start) {
+            apply_entry(config, &entries[input], &entry_config);
+            frame->pga[input] = entries[input].pga;
+        }
+
+        if (input > 0U) {
+            wait_until_us(ready_us);
+        }
+
+        for (size_t chip = 0U; (chip < bank->chip_count) && (ret == ESP_OK); chip++) {
+            ads1115_handle_t* handle = &bank->chips[chip];
+
+            if (input > 0U) {
+                ret = ads1115_handle_read_conversion(handle,
+                    &frame->raw[(chip * entry_count) + (input - 1U)]);
+            }
+
+            if ((ret == ESP_OK) && start) {
+                ret = ads1115_handle_start_single(handle, &entry_config);
+
+                /* The first chip started sets the deadline for the round */
+                if (chip == 0U) {
+                    int64_t started_us = esp_timer_get_time();
+
+                    if (input == 0U) {
+                        frame->timestamp_us = started_us;
+                    }
+
+                    ready_us = started_us +
+                        (int64_t)ads1115_get_conversion_time_us(entry_config.data_rate);
+                }
+            }
+        }
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(BANK_TAG, "Frame aborted: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    frame->duration_us = (uint32_t)(esp_timer_get_time() - frame->timestamp_us);
+
+    ESP_LOGV(BANK_TAG, "Frame of %u channels in %lu us",
+        (unsigned int)frame->channel_count, (unsigned long)frame->duration_us);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_bank_general_call_reset(i2c_master_bus_handle_t bus,
+    uint32_t scl_speed_hz,
+    ads1115_bank_t* bank)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (bus == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret;
+    i2c_master_dev_handle_t general_call = NULL;
+    uint8_t command = ADS1115_GENERAL_CALL_RESET;
+
+    i2c_device_config_t dev_config = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = ADS1115_GENERAL_CALL_ADDRESS,
+        .scl_speed_hz = scl_speed_hz,
+    };
+
+    ret = i2c_master_bus_add_device(bus, &dev_config, &general_call);
+    if (ret != ESP_OK) {
+        ESP_LOGE(BANK_TAG, "Failed to add general-call device: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ret = i2c_master_transmit(general_call, &command, sizeof(command),
+        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+
+    (void)i2c_master_bus_rm_device(general_call);
+
+    /* Device state is unknown after a failed reset as well */
+    if (bank != NULL) {
+        for (size_t chip = 0U; chip < bank->chip_count; chip++) {
+            (void)ads1115_handle_invalidate(&bank->chips[chip]);
+        }
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(BANK_TAG, "General-call reset failed: %s", esp_err_to_name(ret));
+    }
+
+    return ret;
+}
+
+esp_err_t ads1115_bank_get_stats(const ads1115_bank_t* bank,
+    ads1115_bus_stats_t* stats)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((bank == NULL) || (stats == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(stats, 0, sizeof(ads1115_bus_stats_t));
+
+    for (size_t chip = 0U; chip < bank->chip_count; chip++) {
+        const ads1115_bus_stats_t* chip_stats = &bank->chips[chip].stats;
+
+        stats->transactions += chip_stats->transactions;
+        stats->bytes += chip_stats->bytes;
+        stats->transactions_saved += chip_stats->transactions_saved;
+        stats->bytes_saved += chip_stats->bytes_saved;
+    }
+
+    return ESP_OK;
+}
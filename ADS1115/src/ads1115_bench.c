@@ -0,0 +1,255 @@
+/**
+ * @file ads1115_bench.c
+ * @brief ADS1115 on-target CPU cost benchmarks implementation
+ */
+
+#include "ads1115_bench.h"
+#include "esp_cpu.h"
+
+/* Tag for verbosity control in main files */
+static const char* BENCH_TAG = "ADS1115_BENCH";
+
+/**
+ * @brief Fill a block with a deterministic full-scale ramp
+ *
+ * @param raw Output block
+ * @param count Number of samples
+ */
+static void fill_ramp(int16_t* raw, size_t count)
+{
+    const uint32_t step = 65536U / (uint32_t)((count < 65536U) ? count : 65536U);
+
+    for (size_t i = 0U; i < count; i++) {
+        /* CERT-C INT31-C: Wrap in unsigned arithmetic, then reinterpret */
+        raw[i] = (int16_t)(uint16_t)((uint32_t)i * step);
+    }
+}
+
+/**
+ * @brief Per-sample conversion matching the legacy read path
+ *
+ * Kept out of line so each sample pays the call and format branch, as it
+ * does in ads1115_read_single_shot().
+ *
+ * @param raw_value Raw sample
+ * @param config Configuration containing format and scale
+ * @return Converted value
+ */
+static __attribute__((noinline)) float scalar_convert(int16_t raw_value, const ads1115_config_t* config)
+{
+    if (config->data_format == ADS1115_DATA_VOLTAGE) {
+        return (float)raw_value * config->voltage_scale;
+    }
+
+    return (float)raw_value;
+}
+
+/**
+ * @brief Per-sample fixed-point conversion
+ *
+ * Out of line for the same reason as scalar_convert().
+ *
+ * @param raw_value Raw sample
+ * @param pga PGA setting
+ * @return Microvolts
+ */
+static __attribute__((noinline)) int32_t scalar_convert_fixed(int16_t raw_value, ads1115_pga_t pga)
+{
+    return ads1115_raw_to_microvolts(raw_value, pga);
+}
+
+esp_err_t ads1115_bench_convert(int16_t* raw,
+    float* volts,
+    int32_t* microvolts,
+    size_t count,
+    ads1115_bench_convert_t* result)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((raw == NULL) || (volts == NULL) || (microvolts == NULL) ||
+        (result == NULL) || (count == 0U)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ads1115_config_t config;
+    esp_err_t ret = ads1115_init_default_config(&config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    esp_cpu_cycle_count_t start;
+
+    fill_ramp(raw, count);
+    result->samples = (uint32_t)count;
+
+    start = esp_cpu_get_cycle_count();
+    for (size_t i = 0U; i < count; i++) {
+        volts[i] = scalar_convert(raw[i], &config);
+    }
+    result->scalar_cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+
+    start = esp_cpu_get_cycle_count();
+    ret = ads1115_convert_to_volts(raw, count, config.voltage_scale, volts);
+    result->batch_volts_cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    start = esp_cpu_get_cycle_count();
+    ret = ads1115_convert_to_microvolts(raw, count, config.voltage_scale, microvolts);
+    result->batch_microvolts_cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    ESP_LOGI(BENCH_TAG, "Convert %lu samples: scalar %lu, batch volts %lu, batch uV %lu cycles",
+        (unsigned long)result->samples,
+        (unsigned long)result->scalar_cycles,
+        (unsigned long)result->batch_volts_cycles,
+        (unsigned long)result->batch_microvolts_cycles);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_bench_fixed_point(int16_t* raw,
+    float* volts,
+    int32_t* microvolts,
+    size_t count,
+    ads1115_pga_t pga,
+    ads1115_bench_fixed_point_t* result)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((raw == NULL) || (volts == NULL) || (microvolts == NULL) ||
+        (result == NULL) || (count == 0U)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ads1115_config_t config;
+    esp_err_t ret = ads1115_init_default_config(&config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    config.pga = pga;
+    config.voltage_scale = ads1115_get_pga_voltage_scale(pga);
+
+    esp_cpu_cycle_count_t start;
+
+    fill_ramp(raw, count);
+    result->samples = (uint32_t)count;
+
+    start = esp_cpu_get_cycle_count();
+    for (size_t i = 0U; i < count; i++) {
+        volts[i] = scalar_convert(raw[i], &config);
+    }
+    result->float_cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+
+    start = esp_cpu_get_cycle_count();
+    for (size_t i = 0U; i < count; i++) {
+        microvolts[i] = scalar_convert_fixed(raw[i], pga);
+    }
+    result->fixed_cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+
+    start = esp_cpu_get_cycle_count();
+    ret = ads1115_convert_pga_to_microvolts(raw, count, pga, microvolts);
+    result->batch_fixed_cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    /* Accuracy check, outside the timed regions */
+    float max_error_uv = 0.0f;
+
+    for (size_t i = 0U; i < count; i++) {
+        float error_uv = fabsf((volts[i] * 1000000.0f) - (float)microvolts[i]);
+
+        if (error_uv > max_error_uv) {
+            max_error_uv = error_uv;
+        }
+    }
+
+    result->max_error_uv = max_error_uv;
+
+    ESP_LOGI(BENCH_TAG, "%s fixed point, %lu samples: float %lu, fixed %lu, batch fixed %lu cycles, "
+        "max error %.3f uV",
+        CONFIG_IDF_TARGET,
+        (unsigned long)result->samples,
+        (unsigned long)result->float_cycles,
+        (unsigned long)result->fixed_cycles,
+        (unsigned long)result->batch_fixed_cycles,
+        (double)result->max_error_uv);
+
+    if (max_error_uv > (float)ADS1115_UV_TOLERANCE) {
+        ESP_LOGE(BENCH_TAG, "Fixed-point path outside %d uV tolerance", ADS1115_UV_TOLERANCE);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_bench_filter(int16_t* raw,
+    float* volts,
+    int32_t* filtered,
+    size_t count,
+    const ads1115_filter_config_t* filter_config,
+    ads1115_bench_filter_t* result)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((raw == NULL) || (volts == NULL) || (filtered == NULL) ||
+        (filter_config == NULL) || (result == NULL) || (count == 0U)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ads1115_config_t config;
+    ads1115_filter_t filter;
+    esp_err_t ret = ads1115_init_default_config(&config);
+    if (ret == ESP_OK) {
+        ret = ads1115_filter_init(&filter, filter_config);
+    }
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    const uint32_t decimation = ads1115_filter_get_decimation(&filter);
+    esp_cpu_cycle_count_t start;
+    size_t outputs = 0U;
+
+    fill_ramp(raw, count);
+    result->samples = (uint32_t)count;
+
+    /* Naive application loop: float volts, averaged one sample at a time */
+    start = esp_cpu_get_cycle_count();
+    {
+        float accumulator = 0.0f;
+        uint32_t phase = 0U;
+        size_t produced = 0U;
+
+        for (size_t i = 0U; i < count; i++) {
+            accumulator += scalar_convert(raw[i], &config);
+
+            if (++phase == decimation) {
+                volts[produced++] = accumulator / (float)decimation;
+                accumulator = 0.0f;
+                phase = 0U;
+            }
+        }
+    }
+    result->float_cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+
+    start = esp_cpu_get_cycle_count();
+    ret = ads1115_filter_process(&filter, raw, count, filtered, &outputs);
+    result->fixed_cycles = (uint32_t)(esp_cpu_get_cycle_count() - start);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    result->outputs = (uint32_t)outputs;
+
+    ESP_LOGI(BENCH_TAG, "Filter type %d, %lu samples -> %lu outputs: float %lu, fixed %lu cycles",
+        (int)filter_config->type,
+        (unsigned long)result->samples,
+        (unsigned long)result->outputs,
+        (unsigned long)result->float_cycles,
+        (unsigned long)result->fixed_cycles);
+
+    return ESP_OK;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file ads1115_comparator.c
+ * @brief ADS1115 hardware comparator event implementation
+ */
+
+#include "ads1115_comparator.h"
+
+/* Tag for verbosity control in main files */
+static const char* COMP_TAG = "ADS1115_COMP";
+
+/**
+ * @brief ALERT ISR
+ *
+ * Masks the interrupt until ads1115_comparator_acknowledge(), so a latched
+ * or level-triggered ALERT raises a single event.
+ *
+ * @param arg Comparator state
+ */
+static void IRAM_ATTR comparator_isr_handler(void* arg)
+{
+    ads1115_comparator_t* comparator = (ads1115_comparator_t*)arg;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    (void)gpio_intr_disable(comparator->alert_io);
+    comparator->masked = true;
+
+    ads1115_comparator_event_t event = {
+        .alert_io = comparator->alert_io,
+        .timestamp_us = esp_timer_get_time(),
+        .sequence = comparator->events
+    };
+
+    comparator->events++;
+
+    if (comparator->queue != NULL) {
+        if (xQueueSendFromISR(comparator->queue, &event, &higher_priority_task_woken) != pdTRUE) {
+            comparator->dropped++;
+        }
+    }
+
+    if (comparator->callback != NULL) {
+        comparator->callback(&event, comparator->callback_arg);
+    }
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/**
+ * @brief ALERT interrupt type for the configured polarity
+ *
+ * @param polarity Comparator polarity
+ * @param level Use a level interrupt (required for light-sleep wake-up)
+ * @return GPIO interrupt type
+ */
+static gpio_int_type_t alert_intr_type(ads1115_comp_polarity_t polarity, bool level)
+{
+    if (polarity == ADS1115_COMP_POL_HIGH) {
+        return level ? GPIO_INTR_HIGH_LEVEL : GPIO_INTR_POSEDGE;
+    }
+
+    return level ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_NEGEDGE;
+}
+
+/**
+ * @brief Convert and write both thresholds
+ *
+ * @param handle Device handle
+ * @param pga PGA the thresholds apply to
+ * @param lo_thresh_v Lower threshold in volts
+ * @param hi_thresh_v Upper threshold in volts
+ * @return ESP_OK on success, error code otherwise
+ */
+static esp_err_t write_thresholds(ads1115_handle_t* handle, ads1115_pga_t pga,
+    float lo_thresh_v, float hi_thresh_v)
+{
+    int16_t lo_counts = ads1115_comparator_volts_to_counts(lo_thresh_v, pga);
+    int16_t hi_counts = ads1115_comparator_volts_to_counts(hi_thresh_v, pga);
+
+    /* Equal counts would make the comparator meaningless */
+    if (lo_counts >= hi_counts) {
+        ESP_LOGE(COMP_TAG, "Thresholds collapse to %d/%d counts", lo_counts, hi_counts);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ads1115_handle_write_thresholds(handle, lo_counts, hi_counts);
+}
+
+esp_err_t ads1115_comparator_init_default_config(ads1115_comparator_config_t* comparator_config)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (comparator_config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(comparator_config, 0, sizeof(ads1115_comparator_config_t));
+
+    esp_err_t ret = ads1115_init_default_config(&comparator_config->config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    comparator_config->config.pga = ADS1115_PGA_4_096V;
+    comparator_config->config.mode = ADS1115_MODE_CONTINUOUS;
+    comparator_config->config.data_rate = ADS1115_DR_8_SPS;
+    comparator_config->config.comp_mode = ADS1115_COMP_MODE_TRADITIONAL;
+    comparator_config->config.comp_polarity = ADS1115_COMP_POL_LOW;
+    comparator_config->config.comp_latch = ADS1115_COMP_LAT_ENABLED;
+    comparator_config->config.comp_queue = ADS1115_COMP_QUEUE_2;
+    comparator_config->config.data_format = ADS1115_DATA_RAW;
+    comparator_config->alert_io = GPIO_NUM_NC;
+
+    return ESP_OK;
+}
+
+int16_t ads1115_comparator_volts_to_counts(float volts, ads1115_pga_t pga)
+{
+    float counts = volts / ads1115_get_pga_voltage_scale(pga);
+
+    /* CERT-C FLP34-C: Range check before float to integer conversion */
+    if (counts >= (float)ADS1115_MAX_ADC_VALUE) {
+        return (int16_t)ADS1115_MAX_ADC_VALUE;
+    }
+
+    if (counts <= (float)(ADS1115_MIN_ADC_VALUE - 1)) {
+        return (int16_t)(ADS1115_MIN_ADC_VALUE - 1);
+    }
+
+    return (int16_t)lroundf(counts);
+}
+
+esp_err_t ads1115_comparator_start(ads1115_handle_t* handle,
+    const ads1115_comparator_config_t* comparator_config,
+    ads1115_comparator_t* comparator)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((handle == NULL) || (comparator_config == NULL) || (comparator == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!GPIO_IS_VALID_GPIO(comparator_config->alert_io) ||
+        (comparator_config->config.comp_queue == ADS1115_COMP_QUEUE_DISABLE) ||
+        ((comparator_config->queue == NULL) && (comparator_config->callback == NULL))) {
+        ESP_LOGE(COMP_TAG, "Invalid comparator configuration");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret;
+    bool level = comparator_config->light_sleep_wake;
+    gpio_int_type_t intr_type = alert_intr_type(comparator_config->config.comp_polarity, level);
+
+    memset(comparator, 0, sizeof(ads1115_comparator_t));
+    comparator->handle = handle;
+    comparator->config = comparator_config->config;
+    comparator->config.mode = ADS1115_MODE_CONTINUOUS;
+    comparator->alert_io = comparator_config->alert_io;
+    comparator->queue = comparator_config->queue;
+    comparator->callback = comparator_config->callback;
+    comparator->callback_arg = comparator_config->callback_arg;
+
+    ret = write_thresholds(handle, comparator->config.pga,
+        comparator_config->lo_thresh_v, comparator_config->hi_thresh_v);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    /* ALERT/RDY is open-drain in both polarities */
+    gpio_config_t io_config = {
+        .pin_bit_mask = (1ULL << (uint32_t)comparator->alert_io),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = intr_type
+    };
+
+    ret = gpio_config(&io_config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(COMP_TAG, "Failed to configure ALERT GPIO: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    /* ESP_ERR_INVALID_STATE means the service is already installed */
+    ret = gpio_install_isr_service(0);
+    if ((ret != ESP_OK) && (ret != ESP_ERR_INVALID_STATE)) {
+        ESP_LOGE(COMP_TAG, "Failed to install GPIO ISR service: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ret = gpio_isr_handler_add(comparator->alert_io, comparator_isr_handler, comparator);
+    if (ret != ESP_OK) {
+        ESP_LOGE(COMP_TAG, "Failed to add ALERT ISR: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    if (level) {
+        ret = gpio_wakeup_enable(comparator->alert_io, intr_type);
+        if (ret == ESP_OK) {
+            ret = esp_sleep_enable_gpio_wakeup();
+        }
+
+        if (ret != ESP_OK) {
+            ESP_LOGE(COMP_TAG, "Failed to enable light-sleep wake-up: %s", esp_err_to_name(ret));
+            (void)gpio_isr_handler_remove(comparator->alert_io);
+            return ret;
+        }
+
+        comparator->light_sleep_wake = true;
+    }
+
+    comparator->running = true;
+
+    ret = ads1115_handle_configure(handle, &comparator->config);
+    if (ret != ESP_OK) {
+        ESP_LOGE(COMP_TAG, "Failed to start continuous conversion: %s", esp_err_to_name(ret));
+        (void)ads1115_comparator_stop(comparator);
+        return ret;
+    }
+
+    ESP_LOGD(COMP_TAG, "Comparator armed on GPIO %d (%.4f V .. %.4f V)",
+        (int)comparator->alert_io,
+        (double)comparator_config->lo_thresh_v, (double)comparator_config->hi_thresh_v);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_comparator_acknowledge(ads1115_comparator_t* comparator,
+    int16_t* raw)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (comparator == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!comparator->running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    int16_t value = 0;
+
+    /* Reading the conversion register releases a latched ALERT */
+    esp_err_t ret = ads1115_handle_read_conversion(comparator->handle, &value);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    if (raw != NULL) {
+        *raw = value;
+    }
+
+    comparator->masked = false;
+
+    return gpio_intr_enable(comparator->alert_io);
+}
+
+esp_err_t ads1115_comparator_set_thresholds(ads1115_comparator_t* comparator,
+    float lo_thresh_v,
+    float hi_thresh_v)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((comparator == NULL) || (comparator->handle == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return write_thresholds(comparator->handle, comparator->config.pga,
+        lo_thresh_v, hi_thresh_v);
+}
+
+esp_err_t ads1115_comparator_stop(ads1115_comparator_t* comparator)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (comparator == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!comparator->running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    (void)gpio_set_intr_type(comparator->alert_io, GPIO_INTR_DISABLE);
+
+    if (comparator->light_sleep_wake) {
+        (void)gpio_wakeup_disable(comparator->alert_io);
+        (void)esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+        comparator->light_sleep_wake = false;
+    }
+
+    esp_err_t ret = gpio_isr_handler_remove(comparator->alert_io);
+    if (ret != ESP_OK) {
+        ESP_LOGE(COMP_TAG, "Failed to remove ALERT ISR: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    /* An event that was never acknowledged left the pin masked; the type is already disabled */
+    if (comparator->masked) {
+        (void)gpio_intr_enable(comparator->alert_io);
+        comparator->masked = false;
+    }
+
+    comparator->running = false;
+
+    /* Power down with ALERT released */
+    ads1115_config_t idle_config = comparator->config;
+    idle_config.mode = ADS1115_MODE_SINGLE;
+    idle_config.comp_queue = ADS1115_COMP_QUEUE_DISABLE;
+
+    return ads1115_handle_configure(comparator->handle, &idle_config);
+}
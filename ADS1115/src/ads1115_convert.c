@@ -0,0 +1,204 @@
+/**
+ * @file ads1115_convert.c
+ * @brief ADS1115 batch conversion implementation
+ *
+ * Both kernels are unrolled by four over restrict-qualified blocks so the
+ * scale stays in a register and loads, multiplies and stores overlap. The
+ * ESP32-S3 PIE vector unit is not used: it has no floating-point lanes, and
+ * its shifting multiplies have no equivalent of the per-sample Q7 rounding
+ * (half away from zero), so results would differ from the scalar path.
+ */
+
+#include "ads1115_convert.h"
+
+/* Tag for verbosity control in main files */
+static const char* CONVERT_TAG = "ADS1115_CONVERT";
+
+/**
+ * @brief Microvolts per LSB for each PGA setting in Q7 fixed point
+ *
+ * Indexed by PGA bits 11:9; codes 6 and 7 also select ±0.256V
+ */
+static const int32_t PGA_UV_SCALES_Q7[] = {
+    24000,  /* ±6.144V -> 187.5 uV */
+    16000,  /* ±4.096V -> 125.0 uV */
+    8000,   /* ±2.048V -> 62.5 uV */
+    4000,   /* ±1.024V -> 31.25 uV */
+    2000,   /* ±0.512V -> 15.625 uV */
+    1000,   /* ±0.256V -> 7.8125 uV */
+    1000,
+    1000
+};
+
+/**
+ * @brief Divide a Q7 microvolt product, rounding half away from zero
+ *
+ * CERT-C INT13-C: Division instead of shifting a signed value
+ *
+ * @param product Raw sample multiplied by the Q7 scale
+ * @return Microvolts
+ */
+static inline int32_t round_microvolts(int32_t product)
+{
+    const int32_t half = (int32_t)(1U << (ADS1115_UV_SCALE_SHIFT - 1U));
+    const int32_t divisor = (int32_t)(1U << ADS1115_UV_SCALE_SHIFT);
+
+    return (product + ((product >= 0) ? half : -half)) / divisor;
+}
+
+/**
+ * @brief Q7 microvolt scale for a PGA setting
+ *
+ * @param pga PGA setting
+ * @return Q7 microvolts per LSB
+ */
+static inline int32_t pga_uv_scale(ads1115_pga_t pga)
+{
+    /* CERT-C INT31-C: Validate shift operations */
+    return PGA_UV_SCALES_Q7[((uint32_t)pga >> 9U) & 0x07U];
+}
+
+/**
+ * @brief Scale a block by a Q7 microvolt factor
+ *
+ * @param in Raw samples
+ * @param count Number of samples
+ * @param scale Q7 microvolts per LSB
+ * @param out Microvolt output
+ */
+static void scale_microvolts(const int16_t* restrict in, size_t count,
+    int32_t scale, int32_t* restrict out)
+{
+    size_t i = 0U;
+
+    for (; (i + 4U) <= count; i += 4U) {
+        out[i] = round_microvolts((int32_t)in[i] * scale);
+        out[i + 1U] = round_microvolts((int32_t)in[i + 1U] * scale);
+        out[i + 2U] = round_microvolts((int32_t)in[i + 2U] * scale);
+        out[i + 3U] = round_microvolts((int32_t)in[i + 3U] * scale);
+    }
+
+    for (; i < count; i++) {
+        out[i] = round_microvolts((int32_t)in[i] * scale);
+    }
+}
+
+esp_err_t ads1115_convert_to_volts(const int16_t* raw,
+    size_t count,
+    float voltage_scale,
+    float* volts)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((raw == NULL) || (volts == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const int16_t* restrict in = raw;
+    float* restrict out = volts;
+    size_t i = 0U;
+
+    for (; (i + 4U) <= count; i += 4U) {
+        out[i] = (float)in[i] * voltage_scale;
+        out[i + 1U] = (float)in[i + 1U] * voltage_scale;
+        out[i + 2U] = (float)in[i + 2U] * voltage_scale;
+        out[i + 3U] = (float)in[i + 3U] * voltage_scale;
+    }
+
+    for (; i < count; i++) {
+        out[i] = (float)in[i] * voltage_scale;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_convert_to_microvolts(const int16_t* raw,
+    size_t count,
+    float voltage_scale,
+    int32_t* microvolts)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((raw == NULL) || (microvolts == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Q7 microvolts per LSB; exact for all PGA settings (e.g. 7.8125 uV -> 1000) */
+    float scale_q = (voltage_scale * 1000000.0f * (float)(1U << ADS1115_UV_SCALE_SHIFT)) + 0.5f;
+
+    /* CERT-C FLP34-C: Range check before float to integer conversion */
+    if (!(scale_q >= 1.0f) || (scale_q > (float)ADS1115_UV_SCALE_MAX)) {
+        ESP_LOGE(CONVERT_TAG, "Voltage scale %e out of range", (double)voltage_scale);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    scale_microvolts(raw, count, (int32_t)scale_q, microvolts);
+
+    return ESP_OK;
+}
+
+int32_t ads1115_get_pga_uv_scale_q7(ads1115_pga_t pga)
+{
+    return pga_uv_scale(pga);
+}
+
+int32_t ads1115_raw_to_microvolts(int16_t raw, ads1115_pga_t pga)
+{
+    return round_microvolts((int32_t)raw * pga_uv_scale(pga));
+}
+
+esp_err_t ads1115_convert_pga_to_microvolts(const int16_t* raw,
+    size_t count,
+    ads1115_pga_t pga,
+    int32_t* microvolts)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((raw == NULL) || (microvolts == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    scale_microvolts(raw, count, pga_uv_scale(pga), microvolts);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_read_microvolts(i2c_master_dev_handle_t* device_handle,
+    const ads1115_config_t* config,
+    int32_t* microvolts)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((config == NULL) || (microvolts == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int16_t raw = 0;
+
+    esp_err_t ret = ads1115_read_raw(device_handle, config, &raw);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    *microvolts = ads1115_raw_to_microvolts(raw, config->pga);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_handle_read_microvolts(ads1115_handle_t* handle,
+    const ads1115_config_t* config,
+    ads1115_rdy_t* rdy,
+    int32_t* microvolts)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((config == NULL) || (microvolts == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int16_t raw = 0;
+
+    esp_err_t ret = ads1115_handle_read_raw(handle, config, rdy, &raw);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    *microvolts = ads1115_raw_to_microvolts(raw, config->pga);
+
+    return ESP_OK;
+}
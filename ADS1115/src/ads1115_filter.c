@@ -0,0 +1,315 @@
+/**
+ * @file ads1115_filter.c
+ * @brief ADS1115 fixed-point decimation and oversampling filter implementation
+ *
+ * The kernel is selected once per block, so the per-sample loops carry no
+ * type dispatch. CIC state uses modular uint32 arithmetic: integrator
+ * overflow cancels in the combs as long as the output fits, which the
+ * order * log2(decimation) limit guarantees.
+ */
+
+#include "ads1115_filter.h"
+
+/* Tag for verbosity control in main files */
+static const char* FILTER_TAG = "ADS1115_FILTER";
+
+/**
+ * @brief Divide rounding half away from zero
+ *
+ * CERT-C INT13-C: Division instead of shifting a signed value
+ *
+ * @param value Dividend
+ * @param divisor Positive divisor
+ * @return Rounded quotient
+ */
+static inline int32_t divide_rounded(int32_t value, int32_t divisor)
+{
+    int32_t half = divisor / 2;
+
+    return (value + ((value >= 0) ? half : -half)) / divisor;
+}
+
+/**
+ * @brief Boxcar average with decimation
+ */
+static size_t process_moving_average(ads1115_filter_t* filter,
+    const int16_t* restrict raw, size_t count, int32_t* restrict output)
+{
+    const uint32_t length = filter->config.length;
+    const uint32_t decimation = filter->output_decimation;
+    size_t produced = 0U;
+
+    for (size_t i = 0U; i < count; i++) {
+        /* Running sum: add the new sample, drop the one leaving the window */
+        filter->sum += (int32_t)raw[i] - (int32_t)filter->history[filter->index];
+        filter->history[filter->index] = raw[i];
+        filter->index = (filter->index + 1U == length) ? 0U : filter->index + 1U;
+
+        if (filter->filled < length) {
+            filter->filled++;
+        }
+
+        if (++filter->phase == decimation) {
+            filter->phase = 0U;
+
+            /* CERT-C INT32-C: |sum| <= 64 * 32768, shifted sum fits in int32 */
+            output[produced++] = divide_rounded(
+                filter->sum * (int32_t)(1U << ADS1115_FILTER_FRAC_BITS),
+                (int32_t)filter->filled);
+        }
+    }
+
+    return produced;
+}
+
+/**
+ * @brief Cascaded integrator-comb decimator
+ */
+static size_t process_cic(ads1115_filter_t* filter,
+    const int16_t* restrict raw, size_t count, int32_t* restrict output)
+{
+    const uint32_t order = filter->config.order;
+    const uint32_t decimation = filter->output_decimation;
+    uint32_t* restrict integrators = filter->integrators;
+    size_t produced = 0U;
+
+    for (size_t i = 0U; i < count; i++) {
+        /* CERT-C INT30-C: Unsigned wrap-around is intended here */
+        uint32_t value = (uint32_t)(int32_t)raw[i];
+
+        for (uint32_t stage = 0U; stage < order; stage++) {
+            integrators[stage] += value;
+            value = integrators[stage];
+        }
+
+        if (++filter->phase < decimation) {
+            continue;
+        }
+
+        filter->phase = 0U;
+
+        for (uint32_t stage = 0U; stage < order; stage++) {
+            uint32_t delayed = filter->combs[stage];
+
+            filter->combs[stage] = value;
+            value -= delayed;
+        }
+
+        /* Output fits in int32 by the gain limit; remove the decimator gain */
+        int32_t sum = (int32_t)value;
+
+        if (filter->gain_log2 >= ADS1115_FILTER_FRAC_BITS) {
+            output[produced++] = divide_rounded(sum,
+                (int32_t)(1U << (filter->gain_log2 - ADS1115_FILTER_FRAC_BITS)));
+        }
+        else {
+            output[produced++] = sum * (int32_t)(1U << (ADS1115_FILTER_FRAC_BITS - filter->gain_log2));
+        }
+    }
+
+    return produced;
+}
+
+/**
+ * @brief Block median
+ */
+static size_t process_median(ads1115_filter_t* filter,
+    const int16_t* restrict raw, size_t count, int32_t* restrict output)
+{
+    const uint32_t length = filter->config.length;
+    size_t produced = 0U;
+
+    for (size_t i = 0U; i < count; i++) {
+        /* Insertion sort as samples arrive; the block is at most 9 long */
+        uint32_t position = filter->filled;
+        int16_t sample = raw[i];
+
+        while ((position > 0U) && (filter->history[position - 1U] > sample)) {
+            filter->history[position] = filter->history[position - 1U];
+            position--;
+        }
+
+        filter->history[position] = sample;
+
+        if (++filter->filled == length) {
+            filter->filled = 0U;
+            output[produced++] = (int32_t)filter->history[length / 2U] *
+                (int32_t)(1U << ADS1115_FILTER_FRAC_BITS);
+        }
+    }
+
+    return produced;
+}
+
+esp_err_t ads1115_filter_init(ads1115_filter_t* filter,
+    const ads1115_filter_config_t* filter_config)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((filter == NULL) || (filter_config == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t decimation = 1U;
+    uint32_t gain_log2 = 0U;
+    bool valid = false;
+
+    switch (filter_config->type) {
+    case ADS1115_FILTER_NONE:
+        valid = true;
+        break;
+
+    case ADS1115_FILTER_MOVING_AVERAGE:
+        decimation = filter_config->decimation;
+        valid = (filter_config->length >= 1U) &&
+            (filter_config->length <= ADS1115_FILTER_MAX_LENGTH) &&
+            (decimation >= 1U);
+        break;
+
+    case ADS1115_FILTER_CIC:
+        decimation = filter_config->decimation;
+        valid = (decimation >= 2U) && ((decimation & (decimation - 1U)) == 0U) &&
+            (filter_config->order >= 1U) &&
+            (filter_config->order <= ADS1115_FILTER_MAX_CIC_ORDER);
+
+        if (valid) {
+            uint32_t log2_decimation = 0U;
+
+            while ((1U << log2_decimation) < decimation) {
+                log2_decimation++;
+            }
+
+            gain_log2 = filter_config->order * log2_decimation;
+            valid = (gain_log2 <= ADS1115_FILTER_MAX_CIC_GAIN_LOG2);
+        }
+        break;
+
+    case ADS1115_FILTER_MEDIAN:
+        decimation = filter_config->length;
+        valid = (filter_config->length >= 1U) &&
+            (filter_config->length <= ADS1115_FILTER_MAX_MEDIAN) &&
+            ((filter_config->length & 1U) != 0U);
+        break;
+
+    default:
+        break;
+    }
+
+    if (!valid) {
+        ESP_LOGE(FILTER_TAG, "Invalid filter configuration (type %d)", (int)filter_config->type);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(filter, 0, sizeof(ads1115_filter_t));
+    filter->config = *filter_config;
+    filter->output_decimation = decimation;
+    filter->gain_log2 = gain_log2;
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_filter_reset(ads1115_filter_t* filter)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (filter == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(filter->history, 0, sizeof(filter->history));
+    memset(filter->integrators, 0, sizeof(filter->integrators));
+    memset(filter->combs, 0, sizeof(filter->combs));
+    filter->sum = 0;
+    filter->index = 0U;
+    filter->filled = 0U;
+    filter->phase = 0U;
+
+    return ESP_OK;
+}
+
+uint32_t ads1115_filter_get_decimation(const ads1115_filter_t* filter)
+{
+    return (filter == NULL) ? 0U : filter->output_decimation;
+}
+
+esp_err_t ads1115_filter_process(ads1115_filter_t* filter,
+    const int16_t* raw,
+    size_t count,
+    int32_t* output,
+    size_t* output_count)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((filter == NULL) || (raw == NULL) || (output == NULL) || (output_count == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    switch (filter->config.type) {
+    case ADS1115_FILTER_MOVING_AVERAGE:
+        *output_count = process_moving_average(filter, raw, count, output);
+        break;
+
+    case ADS1115_FILTER_CIC:
+        *output_count = process_cic(filter, raw, count, output);
+        break;
+
+    case ADS1115_FILTER_MEDIAN:
+        *output_count = process_median(filter, raw, count, output);
+        break;
+
+    default:
+        for (size_t i = 0U; i < count; i++) {
+            output[i] = (int32_t)raw[i] * (int32_t)(1U << ADS1115_FILTER_FRAC_BITS);
+        }
+        *output_count = count;
+        break;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_filter_stream(ads1115_stream_t* stream,
+    ads1115_filter_t* filter,
+    int32_t* output,
+    size_t output_capacity,
+    size_t* output_count)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((stream == NULL) || (filter == NULL) || (output == NULL) || (output_count == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const int16_t* block = NULL;
+    size_t available;
+    size_t produced = 0U;
+
+    *output_count = 0U;
+
+    while ((produced < output_capacity) &&
+        ((available = ads1115_stream_peek(stream, &block)) > 0U)) {
+        /* Never feed more inputs than the remaining output space can take */
+        size_t room = (output_capacity - produced) * filter->output_decimation;
+        size_t take = (available < room) ? available : room;
+        size_t written = 0U;
+
+        esp_err_t ret = ads1115_filter_process(filter, block, take, &output[produced], &written);
+        if (ret == ESP_OK) {
+            ret = ads1115_stream_release(stream, take);
+        }
+
+        if (ret != ESP_OK) {
+            return ret;
+        }
+
+        produced += written;
+    }
+
+    *output_count = produced;
+
+    return ESP_OK;
+}
+
+int32_t ads1115_filter_to_microvolts(int32_t value, ads1115_pga_t pga)
+{
+    const int64_t divisor = (int64_t)1 << (ADS1115_FILTER_FRAC_BITS + ADS1115_UV_SCALE_SHIFT);
+    int64_t product = (int64_t)value * (int64_t)ads1115_get_pga_uv_scale_q7(pga);
+
+    return (int32_t)((product + ((product >= 0) ? (divisor / 2) : -(divisor / 2))) / divisor);
+}
@@ -0,0 +1,348 @@
+/**
+ * @file ads1115_stream.c
+ * @brief ADS1115 continuous-mode background streaming implementation
+ *
+ * Lock-free single-producer/single-consumer ring buffer fed by a pinned
+ * acquisition task. Index publication uses acquire/release ordering so the
+ * producer and consumer may run on different cores.
+ */
+
+#include "ads1115_stream.h"
+
+/* Tag for verbosity control in main files */
+static const char* STREAM_TAG = "ADS1115_STREAM";
+
+/**
+ * @brief Pacing timer callback
+ *
+ * Wakes the acquisition task once per nominal conversion period.
+ *
+ * @param arg Stream state
+ */
+static void stream_timer_callback(void* arg)
+{
+    ads1115_stream_t* stream = (ads1115_stream_t*)arg;
+
+    (void)xTaskNotifyGive(stream->task);
+}
+
+/**
+ * @brief Read one conversion and push it into the ring buffer
+ *
+ * The address pointer was set to the conversion register at start, so the
+ * read is a bare 2-byte receive.
+ *
+ * @param stream Stream state
+ */
+static void stream_produce(ads1115_stream_t* stream)
+{
+    uint8_t read_buffer[ADS1115_REGISTER_SIZE_BYTES] = { 0 };
+
+    esp_err_t ret = i2c_master_receive(stream->device,
+        read_buffer, sizeof(read_buffer),
+        pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+
+    if (ret != ESP_OK) {
+        stream->read_errors++;
+        return;
+    }
+
+    uint32_t head = __atomic_load_n(&stream->head, __ATOMIC_RELAXED);
+    uint32_t tail = __atomic_load_n(&stream->tail, __ATOMIC_ACQUIRE);
+
+    /* Drop the newest sample rather than overwrite unread data */
+    if ((head - tail) > stream->mask) {
+        stream->overruns++;
+        return;
+    }
+
+    /* CERT-C INT31-C: Safe bit operations */
+    stream->buffer[head & stream->mask] = (int16_t)((uint16_t)(read_buffer[0] << 8U) |
+        (uint16_t)read_buffer[1]);
+
+    __atomic_store_n(&stream->head, head + 1U, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Acquisition task
+ *
+ * Each notification (ALERT/RDY pulse or pacing timer) corresponds to one
+ * completed conversion; a count above one means conversions were skipped.
+ *
+ * @param arg Stream state
+ */
+static void stream_task(void* arg)
+{
+    ads1115_stream_t* stream = (ads1115_stream_t*)arg;
+
+    /* Generous timeout so a stalled ALERT/RDY line shows up as a read error */
+    TickType_t timeout_ticks = pdMS_TO_TICKS(
+        (2U * ads1115_get_conversion_time_us(stream->config.data_rate)) / 1000U) + 2U;
+
+    while (!stream->stop_requested) {
+        uint32_t events = ulTaskNotifyTake(pdTRUE, timeout_ticks);
+
+        if (stream->stop_requested) {
+            break;
+        }
+
+        if (events == 0U) {
+            stream->read_errors++;
+            ESP_LOGW(STREAM_TAG, "No conversion event within timeout");
+            continue;
+        }
+
+        if (stream->period_us != 0U) {
+            /* Conversions completed since start at the nominal rate; any the
+               task did not get to in time are counted, however late it ran */
+            uint32_t due = (uint32_t)((esp_timer_get_time() - stream->start_us) /
+                (int64_t)stream->period_us);
+
+            if (due > (stream->last_due + 1U)) {
+                stream->missed += due - stream->last_due - 1U;
+            }
+
+            stream->last_due = (due > stream->last_due) ? due : (stream->last_due + 1U);
+        }
+        else if (events > 1U) {
+            stream->missed += events - 1U;
+        }
+
+        stream_produce(stream);
+    }
+
+    stream->running = false;
+    vTaskDelete(NULL);
+}
+
+esp_err_t ads1115_stream_init_default_config(ads1115_stream_config_t* stream_config)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (stream_config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(stream_config, 0, sizeof(ads1115_stream_config_t));
+
+    esp_err_t ret = ads1115_init_default_config(&stream_config->config);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    stream_config->config.mode = ADS1115_MODE_CONTINUOUS;
+    stream_config->config.data_rate = ADS1115_DR_860_SPS;
+    stream_config->config.data_format = ADS1115_DATA_RAW;
+    stream_config->alert_io = GPIO_NUM_NC;
+    stream_config->core_id = tskNO_AFFINITY;
+    stream_config->task_priority = ADS1115_STREAM_TASK_PRIORITY;
+    stream_config->task_stack_size = ADS1115_STREAM_TASK_STACK_SIZE;
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_stream_start(i2c_master_dev_handle_t* device_handle,
+    const ads1115_stream_config_t* stream_config,
+    ads1115_stream_t* stream)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((device_handle == NULL) || (*device_handle == NULL) ||
+        (stream_config == NULL) || (stream == NULL) || (stream_config->buffer == NULL)) {
+        ESP_LOGE(STREAM_TAG, "Invalid stream parameters");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Ring indices are masked, so the length must be a power of two */
+    size_t length = stream_config->buffer_length;
+    if ((length < 2U) || ((length & (length - 1U)) != 0U)) {
+        ESP_LOGE(STREAM_TAG, "Buffer length %u is not a power of two", (unsigned int)length);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret;
+    bool use_rdy = (stream_config->alert_io != GPIO_NUM_NC);
+
+    memset(stream, 0, sizeof(ads1115_stream_t));
+    stream->device = *device_handle;
+    stream->config = stream_config->config;
+    stream->config.mode = ADS1115_MODE_CONTINUOUS;
+    stream->buffer = stream_config->buffer;
+    stream->mask = (uint32_t)(length - 1U);
+
+    if (use_rdy) {
+        ret = ads1115_rdy_enable(device_handle, &stream->rdy, stream_config->alert_io);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+
+        /* In continuous mode ALERT/RDY pulses low once per conversion */
+        stream->config.comp_mode = ADS1115_COMP_MODE_TRADITIONAL;
+        stream->config.comp_polarity = ADS1115_COMP_POL_LOW;
+        stream->config.comp_latch = ADS1115_COMP_LAT_DISABLED;
+        stream->config.comp_queue = ADS1115_COMP_QUEUE_1;
+    }
+
+    ret = ads1115_configure(device_handle, &stream->config);
+
+    /* Leave the address pointer at the conversion register */
+    if (ret == ESP_OK) {
+        uint8_t reg_addr = ADS1115_REG_CONVERSION;
+
+        ret = i2c_master_transmit(stream->device, &reg_addr, sizeof(reg_addr),
+            pdMS_TO_TICKS(ADS1115_I2C_TIMEOUT_MS));
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(STREAM_TAG, "Failed to configure continuous mode: %s", esp_err_to_name(ret));
+        if (use_rdy) {
+            (void)ads1115_rdy_disable(&stream->rdy);
+        }
+        return ret;
+    }
+
+    stream->running = true;
+
+    BaseType_t created = xTaskCreatePinnedToCore(stream_task, "ads1115_stream",
+        stream_config->task_stack_size, stream,
+        stream_config->task_priority, &stream->task,
+        stream_config->core_id);
+
+    if (created != pdPASS) {
+        ESP_LOGE(STREAM_TAG, "Failed to create acquisition task");
+        stream->running = false;
+        if (use_rdy) {
+            (void)ads1115_rdy_disable(&stream->rdy);
+        }
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (use_rdy) {
+        /* ISR notifications now go straight to the acquisition task */
+        stream->rdy.waiting_task = stream->task;
+        ESP_LOGD(STREAM_TAG, "Streaming started (ALERT/RDY pacing)");
+        return ESP_OK;
+    }
+
+    esp_timer_create_args_t timer_args = {
+        .callback = stream_timer_callback,
+        .arg = stream,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "ads1115_stream",
+        .skip_unhandled_events = false
+    };
+
+    /* Paced at the nominal period: the worst-case time would read ~10% fewer samples than configured */
+    stream->period_us = ads1115_get_data_rate_period_us(stream->config.data_rate);
+    stream->start_us = esp_timer_get_time();
+
+    ret = esp_timer_create(&timer_args, &stream->timer);
+    if (ret == ESP_OK) {
+        ret = esp_timer_start_periodic(stream->timer, stream->period_us);
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(STREAM_TAG, "Failed to start pacing timer: %s", esp_err_to_name(ret));
+        (void)ads1115_stream_stop(stream);
+        return ret;
+    }
+
+    ESP_LOGD(STREAM_TAG, "Streaming started (timer pacing)");
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_stream_stop(ads1115_stream_t* stream)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (stream == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!stream->running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    /* Stop the pacing source before the task */
+    if (stream->timer != NULL) {
+        (void)esp_timer_stop(stream->timer);
+        (void)esp_timer_delete(stream->timer);
+        stream->timer = NULL;
+    }
+
+    if (stream->rdy.enabled) {
+        (void)ads1115_rdy_disable(&stream->rdy);
+    }
+
+    stream->stop_requested = true;
+    (void)xTaskNotifyGive(stream->task);
+
+    TickType_t max_wait_ticks = pdMS_TO_TICKS(ADS1115_STREAM_STOP_TIMEOUT_MS) + 1U;
+
+    for (TickType_t waited = 0U; stream->running; waited++) {
+        if (waited >= max_wait_ticks) {
+            ESP_LOGE(STREAM_TAG, "Acquisition task did not exit");
+            return ESP_ERR_TIMEOUT;
+        }
+        vTaskDelay(1U);
+    }
+
+    stream->task = NULL;
+
+    /* Return to single-shot mode so the device powers down */
+    ads1115_config_t idle_config = stream->config;
+    idle_config.mode = ADS1115_MODE_SINGLE;
+
+    return ads1115_configure(&stream->device, &idle_config);
+}
+
+size_t ads1115_stream_peek(ads1115_stream_t* stream, const int16_t** block)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((stream == NULL) || (block == NULL) || (stream->buffer == NULL)) {
+        return 0U;
+    }
+
+    uint32_t head = __atomic_load_n(&stream->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&stream->tail, __ATOMIC_RELAXED);
+    uint32_t available = head - tail;
+    uint32_t index = tail & stream->mask;
+    uint32_t until_wrap = (stream->mask + 1U) - index;
+
+    *block = &stream->buffer[index];
+
+    return (size_t)((available < until_wrap) ? available : until_wrap);
+}
+
+esp_err_t ads1115_stream_release(ads1115_stream_t* stream, size_t count)
+{
+    /* CERT-C EXP34-C: Validate pointer */
+    if (stream == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint32_t head = __atomic_load_n(&stream->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&stream->tail, __ATOMIC_RELAXED);
+
+    if (count > (size_t)(head - tail)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    __atomic_store_n(&stream->tail, tail + (uint32_t)count, __ATOMIC_RELEASE);
+
+    return ESP_OK;
+}
+
+esp_err_t ads1115_stream_get_stats(const ads1115_stream_t* stream,
+    ads1115_stream_stats_t* stats)
+{
+    /* CERT-C EXP34-C: Parameter validation */
+    if ((stream == NULL) || (stats == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    stats->produced = __atomic_load_n(&stream->head, __ATOMIC_ACQUIRE);
+    stats->overruns = stream->overruns;
+    stats->missed = stream->missed;
+    stats->read_errors = stream->read_errors;
+
+    return ESP_OK;
+}
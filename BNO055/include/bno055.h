@@ -11,8 +11,13 @@
 #include "esp_log.h"
 #include "driver/i2c_master.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
 #include "esp_err.h"
 #include "helpers_bno055.h"
+#include "bno055_transport.h"
 
 typedef enum bno055_reg_t
 {
@@ -190,7 +195,47 @@ typedef enum bno055_sensor_t
     TEMPERATURE = 52
 } bno055_sensor_t;
 
-// TODO Modify the power modes properly
+// Accelerometer data through calibration status (0x08 - 0x35) in one auto-increment read
+#define BNO055_OUTPUT_BURST_LENGTH (CALIB_STAT - ACC_DATA_X_LSB + 1)
+
+// Standard gravity in the two accelerometer units
+#define BNO055_GRAVITY_M_S2 9.80665f
+#define BNO055_GRAVITY_MG 1000.0f
+
+// Bytes a new read transaction costs on the wire: device address (W), register address, device address (R)
+#define BNO055_TRANSACTION_OVERHEAD_BYTES 3
+#define BNO055_MAX_READ_SPANS 9
+
+typedef enum bno055_sensor_mask_t
+{
+    ACCELEROMETER_MASK = 0x001,
+    MAGNETOMETER_MASK = 0x002,
+    GYROSCOPE_MASK = 0x004,
+    EULER_ANGLE_MASK = 0x008,
+    QUATERNION_MASK = 0x010,
+    LINEAR_ACCELERATION_MASK = 0x020,
+    GRAVITY_MASK = 0x040,
+    TEMPERATURE_MASK = 0x080,
+    CALIBRATION_STATUS_MASK = 0x100,
+    ALL_SENSORS_MASK = 0x1ff
+} bno055_sensor_mask_t;
+
+typedef struct bno055_read_span_t
+{
+    uint8_t register_address;
+    uint8_t length;
+} bno055_read_span_t;
+
+typedef struct bno055_read_plan_t
+{
+    uint16_t sensor_mask;                            // Outputs decoded after the read
+    uint8_t span_count;                              // Burst reads (transactions) per execution
+    bno055_read_span_t spans[BNO055_MAX_READ_SPANS]; // Register spans in address order
+    uint16_t data_bytes;                             // Bytes read, including merged gaps
+    uint16_t bus_bytes;                              // data_bytes plus addressing overhead per transaction
+} bno055_read_plan_t;
+
+// PWR_MODE values
 typedef enum bno055_power_mode_t
 {
     NORMAL_MODE = 0x00,
@@ -198,6 +243,90 @@ typedef enum bno055_power_mode_t
     SUSPEND_MODE = 0x02
 } bno055_power_mode_t;
 
+// Datasheet 3.4 placements as AXIS_MAP_CONFIG << 8 | AXIS_MAP_SIGN, P1 is the reset default
+typedef enum bno055_axis_placement_t
+{
+    PLACEMENT_P0 = 0x2104,
+    PLACEMENT_P1 = 0x2400,
+    PLACEMENT_P2 = 0x2406,
+    PLACEMENT_P3 = 0x2102,
+    PLACEMENT_P4 = 0x2403,
+    PLACEMENT_P5 = 0x2101,
+    PLACEMENT_P6 = 0x2107,
+    PLACEMENT_P7 = 0x2405
+} bno055_axis_placement_t;
+
+// AXIS_MAP_CONFIG fields, the source axis of each remapped axis
+#define BNO055_AXIS_SOURCE_X 0x00
+#define BNO055_AXIS_SOURCE_Y 0x01
+#define BNO055_AXIS_SOURCE_Z 0x02
+#define BNO055_AXIS_MAP(x_source, y_source, z_source) (((z_source) << 4) | ((y_source) << 2) | (x_source))
+
+// AXIS_MAP_SIGN bits, set for a negative remapped axis
+#define BNO055_AXIS_SIGN_X 0x04
+#define BNO055_AXIS_SIGN_Y 0x02
+#define BNO055_AXIS_SIGN_Z 0x01
+
+#define BNO055_CHIP_ID 0xA0
+
+// SYS_STATUS values
+#define BNO055_SYS_STATUS_IDLE 0x00
+#define BNO055_SYS_STATUS_ERROR 0x01
+#define BNO055_SYS_STATUS_FUSION 0x05
+#define BNO055_SYS_STATUS_NO_FUSION 0x06
+
+// Startup polling bounds, from the datasheet timings with margin
+#define BNO055_BOOT_TIMEOUT_MS 1000       // Reset to CONFIG mode, 650 ms typical
+#define BNO055_CLOCK_TIMEOUT_MS 700       // Clock source switch
+#define BNO055_TO_CONFIG_TIMEOUT_MS 40    // Any mode to CONFIG, 19 ms
+#define BNO055_FROM_CONFIG_TIMEOUT_MS 20  // CONFIG to any mode, 7 ms
+#define BNO055_FROM_SUSPEND_TIMEOUT_MS 150 // Suspend to normal, bounded by the gyroscope start-up
+#define BNO055_POLL_INTERVAL_MS 1
+#define BNO055_POLL_BUS_TIMEOUT_MS 10
+#define BNO055_RESET_PULSE_US 10
+
+// Measured duration of each startup phase
+typedef struct bno055_startup_timing_t
+{
+    int64_t boot_us;        // Reset until CHIP_ID answers and the system is idle
+    int64_t config_us;      // Chip ID check, page 0 and CONFIG mode
+    int64_t crystal_us;     // External crystal switch
+    int64_t units_us;       // Unit selection
+    int64_t calibration_us; // Restoring the stored calibration profile, if any
+    int64_t mode_us;        // Entering the requested operation mode until SYS_STATUS reports it running
+    int64_t total_us;
+} bno055_startup_timing_t;
+
+// ACC_OFFSET_X_LSB through MAG_RADIUS_MSB
+#define BNO055_CALIBRATION_PROFILE_LENGTH (MAG_RADIUS_MSB - ACC_OFFSET_X_LSB + 1)
+#define BNO055_MAX_WRITE_LENGTH BNO055_CALIBRATION_PROFILE_LENGTH
+
+// Offset and radius registers exactly as read from the device, independent of the selected units
+typedef struct bno055_calibration_profile_t
+{
+    uint8_t data[BNO055_CALIBRATION_PROFILE_LENGTH];
+} bno055_calibration_profile_t;
+
+// Valid bits of bno055_state_t
+#define BNO055_STATE_PAGE 0x01
+#define BNO055_STATE_OPR_MODE 0x02
+#define BNO055_STATE_UNITS 0x04
+#define BNO055_STATE_CRYSTAL 0x08
+#define BNO055_STATE_POWER_MODE 0x10
+#define BNO055_STATE_AXIS_MAP 0x20 // The device holds bno055_config.axis_map_config and axis_map_sign
+#define BNO055_STATE_RESUME_MODE 0x40 // operation_mode was written on the way into suspend and is not read back yet
+
+// Last written device state; a set valid bit means the register does not need to be read or written again
+typedef struct bno055_state_t
+{
+    uint8_t valid;
+    uint8_t page;
+    bno055_operation_mode_t operation_mode;
+    uint8_t units;
+    bool external_crystal;
+    bno055_power_mode_t power_mode;
+} bno055_state_t;
+
 typedef struct imu_t
 {
     vector_t raw_acceleration;
@@ -207,8 +336,16 @@ typedef struct imu_t
     quaternion_t quaternion;
     vector_t linear_acceleration;
     vector_t gravity;
+    rotation_matrix_t rotation_matrix;
     float temperature;
+    uint8_t calibration_status;
     sensor_config_t bno055_config;
+    bno055_state_t state;
+    bno055_transport_t transport; // I2C unless bno055_transport_uart_init() was called on it
+    // Recursive mutex around every register access, so the page and state caches stay consistent when several tasks share the device.
+    // Created by bno055_initialize(), bno055_reset() and bno055_startup(); NULL until then, which leaves access unserialised
+    SemaphoreHandle_t lock;
+    StaticSemaphore_t lock_buffer;
 } imu_t;
 
 #ifdef __cplusplus
@@ -218,24 +355,65 @@ extern "C"
 
     esp_err_t bno055_initialize(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
 
+    // Every bus API takes the lock itself, hold it across several calls to make the sequence atomic
+    void bno055_lock(imu_t *imu);
+
+    void bno055_unlock(imu_t *imu);
+
     esp_err_t bno055_configure(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode, uint8_t units_selected);
 
     esp_err_t bno055_reset(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
 
+    esp_err_t bno055_startup(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode, uint8_t units_selected, bno055_startup_timing_t *timing);
+
+    esp_err_t bno055_set_operation_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode);
+
+    void bno055_invalidate_state(imu_t *imu);
+
+    void bno055_refresh_sensor_scale(imu_t *imu);
+
+    esp_err_t bno055_read_registers(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t page, uint8_t register_address, uint8_t *register_content, size_t length);
+
+    esp_err_t bno055_write_registers(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t page, uint8_t register_address, const uint8_t *register_content, size_t length);
+
+    esp_err_t bno055_enter_config_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t *previous_mode);
+
+    esp_err_t bno055_reset_interrupts(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
+
     esp_err_t bno055_calibration_status(i2c_master_dev_handle_t *slave_handle);
 
+    // Reads CALIB_STAT into imu->calibration_status over the imu's transport
+    esp_err_t bno055_get_calibration_status(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
+
     esp_err_t bno055_get_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_sensor_t sensor);
 
-    esp_err_t bno055_get_offsets(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
+    esp_err_t bno055_get_all_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
+
+    uint16_t bno055_sensor_to_mask(bno055_sensor_t sensor);
+
+    esp_err_t bno055_plan_readings(uint16_t sensor_mask, uint8_t transaction_overhead, bno055_read_plan_t *plan);
 
-    // TODO Below functions to be engineered
-    esp_err_t bno055_set_axis(i2c_master_dev_handle_t *slave_handle, uint8_t axis_remap, uint8_t axis_sign);
+    esp_err_t bno055_get_planned_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_read_plan_t *plan);
 
-    esp_err_t bno055_power_mode_set(i2c_master_dev_handle_t *slave_handle, bno055_power_mode_t power_mode);
+    esp_err_t bno055_get_sensor_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint16_t sensor_mask);
+
+    void bno055_derive_orientation(imu_t *imu);
+
+    esp_err_t bno055_get_orientation(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
+
+    esp_err_t bno055_get_offsets(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
 
     esp_err_t bno055_set_offsets(i2c_master_dev_handle_t *slave_handle, imu_t *imu);
 
-    // TODO Add in functions that use the BNO055's interrupts
+    esp_err_t bno055_get_calibration_profile(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_calibration_profile_t *profile);
+
+    esp_err_t bno055_set_calibration_profile(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_calibration_profile_t *profile);
+
+    esp_err_t bno055_power_mode_set(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_power_mode_t power_mode);
+
+    esp_err_t bno055_set_axis(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t axis_remap, uint8_t axis_sign);
+
+    esp_err_t bno055_set_axis_placement(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_axis_placement_t placement);
 
 #ifdef __cplusplus
 }
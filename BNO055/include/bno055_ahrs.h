@@ -0,0 +1,71 @@
+#ifndef _BNO055_AHRS_H_
+#define _BNO055_AHRS_H_
+
+#pragma once
+
+#include "bno055.h"
+#include "bno055_raw.h"
+
+// Longest gap integrated in one step, a longer one (a stalled reader) is clamped
+#define BNO055_AHRS_MAX_DT_S 0.1f
+
+// Lanes of the batch kernel, one per device of a full group
+#define BNO055_AHRS_BATCH_SIZE 4
+
+typedef enum bno055_ahrs_filter_t
+{
+    MADGWICK_FILTER, // Gradient descent, one gain
+    MAHONY_FILTER    // Complementary PI controller, cheaper and with gyroscope bias correction through ki
+} bno055_ahrs_filter_t;
+
+typedef struct bno055_ahrs_config_t
+{
+    bno055_ahrs_filter_t filter;
+    float beta; // Madgwick gain, rad/s of gyroscope error corrected
+    float kp;   // Mahony proportional gain
+    float ki;   // Mahony integral gain, 0 disables bias correction
+} bno055_ahrs_config_t;
+
+// Allocated by the caller, one per device
+typedef struct bno055_ahrs_t
+{
+    bno055_ahrs_config_t config;
+    quaternion_t quaternion;   // Sensor to world (north, west, up), the same convention as the chip's quaternion
+    vector_t integral_error;   // Mahony bias estimate, rad/s
+    int64_t last_timestamp_us; // Time of the last sample, 0 before the first
+    uint32_t updates;
+} bno055_ahrs_t;
+
+// Structure of arrays so every lane runs the same straight-line code, a zero accelerometer vector in a lane integrates its gyroscope only
+typedef struct bno055_ahrs_batch_t
+{
+    float qw[BNO055_AHRS_BATCH_SIZE], qx[BNO055_AHRS_BATCH_SIZE], qy[BNO055_AHRS_BATCH_SIZE], qz[BNO055_AHRS_BATCH_SIZE];
+    float gx[BNO055_AHRS_BATCH_SIZE], gy[BNO055_AHRS_BATCH_SIZE], gz[BNO055_AHRS_BATCH_SIZE]; // rad/s
+    float ax[BNO055_AHRS_BATCH_SIZE], ay[BNO055_AHRS_BATCH_SIZE], az[BNO055_AHRS_BATCH_SIZE];
+    float mx[BNO055_AHRS_BATCH_SIZE], my[BNO055_AHRS_BATCH_SIZE], mz[BNO055_AHRS_BATCH_SIZE];
+} __attribute__((aligned(16))) bno055_ahrs_batch_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_ahrs_init_default_config(bno055_ahrs_config_t *ahrs_config);
+
+    esp_err_t bno055_ahrs_init(bno055_ahrs_t *ahrs, const bno055_ahrs_config_t *ahrs_config);
+
+    void bno055_ahrs_update(bno055_ahrs_t *ahrs, const vector_t *gyroscope, const vector_t *acceleration, const vector_t *magnetometer, float dt);
+
+    esp_err_t bno055_ahrs_update_imu(bno055_ahrs_t *ahrs, imu_t *imu, int64_t timestamp_us);
+
+    esp_err_t bno055_ahrs_update_raw(bno055_ahrs_t *ahrs, imu_t *imu, const bno055_raw_sample_t *sample);
+
+    esp_err_t bno055_ahrs_read(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_ahrs_t *ahrs);
+
+    void bno055_ahrs_batch_update(bno055_ahrs_batch_t *batch, size_t count, float beta, float dt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
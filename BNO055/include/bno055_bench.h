@@ -0,0 +1,77 @@
+#ifndef _BNO055_BENCH_H_
+#define _BNO055_BENCH_H_
+
+#pragma once
+
+#include "esp_cpu.h"
+#include "bno055.h"
+#include "bno055_ahrs.h"
+
+typedef struct bno055_bench_orientation_t
+{
+    uint32_t iterations;
+    uint32_t derive_cycles;      // Average CPU cycles of bno055_derive_orientation()
+    uint32_t quaternion_read_us; // Average bus time reading the quaternion only
+    uint32_t chip_read_us;       // Average bus time reading Euler angles, quaternion and gravity from the chip
+    uint16_t quaternion_bus_bytes;
+    uint16_t chip_bus_bytes;
+    float max_euler_error;   // Largest host versus chip Euler difference, in Euler units
+    float max_gravity_error; // Largest host versus chip gravity difference, in acceleration units
+} bno055_bench_orientation_t;
+
+// Same fields on either transport, so an I2C and a UART run compare directly
+typedef struct bno055_bench_transport_t
+{
+    bno055_transport_type_t type;
+    uint32_t iterations;
+    uint32_t single_read_us;     // Average one-byte register read
+    uint32_t single_read_max_us; // Longest one-byte register read
+    uint32_t burst_read_us;      // Average burst read of every output register
+    uint32_t burst_read_max_us;  // Longest burst read
+    uint16_t burst_bytes;
+    uint32_t errors;  // Failed transactions
+    uint32_t retries; // UART frames repeated after a bus over-run
+} bno055_bench_transport_t;
+
+// One NDOF step: the fusion inputs and the chip's own answer, captured in a single burst
+typedef struct bno055_ahrs_record_t
+{
+    vector_t gyroscope; // rad/s
+    vector_t acceleration;
+    vector_t magnetometer;
+    quaternion_t quaternion; // Chip fusion output
+    int64_t timestamp_us;
+} bno055_ahrs_record_t;
+
+typedef struct bno055_bench_ahrs_t
+{
+    bno055_ahrs_filter_t filter;
+    uint32_t updates;
+    uint32_t update_cycles;     // Average CPU cycles of one bno055_ahrs_update()
+    uint32_t update_max_cycles; // Longest update
+    uint32_t batch_lane_cycles; // Average CPU cycles of a full bno055_ahrs_batch_update() divided by its lanes
+    uint32_t compared;          // Records after the settling period
+    float mean_error_deg;       // Average rotation between host and chip quaternions
+    float max_error_deg;
+    float max_tilt_error_deg;    // Largest angle between host and chip gravity directions
+    float max_heading_error_deg; // Largest heading difference, wrapped to 180 degrees
+} bno055_bench_ahrs_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_bench_orientation(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint32_t iterations, bno055_bench_orientation_t *result);
+
+    esp_err_t bno055_bench_transport(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint32_t iterations, bno055_bench_transport_t *result);
+
+    esp_err_t bno055_bench_ahrs_record(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_ahrs_record_t *records, uint32_t count);
+
+    esp_err_t bno055_bench_ahrs_replay(const bno055_ahrs_config_t *ahrs_config, const bno055_ahrs_record_t *records, uint32_t count, uint32_t settle_count, bno055_bench_ahrs_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef _BNO055_CALIBRATION_H_
+#define _BNO055_CALIBRATION_H_
+
+#pragma once
+
+#include "nvs.h"
+#include "bno055.h"
+
+#define BNO055_CALIBRATION_NVS_NAMESPACE "bno055"
+#define BNO055_CALIBRATION_BLOB_VERSION 1
+
+// Stored in NVS; a blob with another version or length is rejected rather than applied
+typedef struct bno055_calibration_blob_t
+{
+    uint16_t version;
+    uint8_t length;             // BNO055_CALIBRATION_PROFILE_LENGTH
+    uint8_t calibration_status; // CALIB_STAT when the profile was saved
+    bno055_calibration_profile_t profile;
+} bno055_calibration_blob_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_save_calibration(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const char *key);
+
+    esp_err_t bno055_restore_calibration(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const char *key);
+
+    esp_err_t bno055_erase_calibration(const char *key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
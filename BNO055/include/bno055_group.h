@@ -0,0 +1,111 @@
+#ifndef _BNO055_GROUP_H_
+#define _BNO055_GROUP_H_
+
+#pragma once
+
+#include "bno055.h"
+#include "bno055_sampler.h"
+
+// Two I2C controllers with the two BNO055 addresses (0x28 and 0x29) on each
+#define BNO055_GROUP_MAX_BUSES 2
+#define BNO055_GROUP_MAX_DEVICES_PER_BUS 2
+#define BNO055_GROUP_MAX_DEVICES (BNO055_GROUP_MAX_BUSES * BNO055_GROUP_MAX_DEVICES_PER_BUS)
+#define BNO055_GROUP_TASK_STACK 4096
+
+typedef struct bno055_group_device_t
+{
+    i2c_master_dev_handle_t *slave_handle;
+    imu_t *imu;
+    uint8_t bus; // Acquisition task reading this device, devices sharing a controller must share a bus
+} bno055_group_device_t;
+
+typedef struct bno055_group_config_t
+{
+    bno055_group_device_t devices[BNO055_GROUP_MAX_DEVICES];
+    uint8_t device_count;
+    uint16_t sensor_mask; // bno055_sensor_mask_t bits read from every device each period
+    uint32_t period_ms;
+    UBaseType_t task_priority;
+    BaseType_t core_ids[BNO055_GROUP_MAX_BUSES]; // Core of each bus task, one per core by default
+} bno055_group_config_t;
+
+// One sample of every device, all read in answer to the same trigger
+typedef struct bno055_group_frame_t
+{
+    bno055_snapshot_t devices[BNO055_GROUP_MAX_DEVICES]; // In configuration order, timestamp_us is the middle of each burst read
+    uint8_t valid_mask;                                  // Bit per device read without error in this frame
+    uint32_t sequence;                                   // Frame number, starting at 1
+    int64_t trigger_us;                                  // esp_timer time the frame was triggered
+    uint32_t skew_us;                                    // Latest minus earliest device timestamp
+    uint32_t duration_us;                                // Trigger until the last device was read
+} bno055_group_frame_t;
+
+typedef struct bno055_group_stats_t
+{
+    uint32_t frames;         // Frames published
+    uint32_t overruns;       // Triggers skipped because the previous frame was still being read
+    uint32_t read_errors;    // Failed device reads
+    uint32_t reader_retries; // Reader copies repeated because a frame was being published
+    uint32_t last_skew_us;
+    uint32_t max_skew_us;
+    uint32_t mean_skew_us;
+    uint32_t max_duration_us;                     // Longest trigger to last read
+    uint32_t max_bus_us[BNO055_GROUP_MAX_BUSES]; // Longest time each bus task took for its devices
+} bno055_group_stats_t;
+
+typedef struct bno055_group_t bno055_group_t;
+
+typedef struct bno055_group_bus_t
+{
+    bno055_group_t *group;
+    uint8_t device_count;
+    uint8_t devices[BNO055_GROUP_MAX_DEVICES_PER_BUS]; // Indices into the configuration
+    TaskHandle_t task;
+    volatile uint32_t max_bus_us;
+    volatile bool running;
+} bno055_group_bus_t;
+
+// Allocated by the caller, all fields are internal
+struct bno055_group_t
+{
+    bno055_group_config_t config;
+    bno055_read_plan_t plan;
+    bno055_group_bus_t buses[BNO055_GROUP_MAX_BUSES];
+    uint8_t bus_count;
+    esp_timer_handle_t timer;
+    bno055_group_frame_t assembly; // Written by the bus tasks, each to its own devices
+    bno055_group_frame_t frame;    // Published copy
+    portMUX_TYPE write_lock;
+    volatile uint32_t seqlock; // Odd while the published frame is being written
+    volatile uint32_t pending; // Bus tasks still reading the current frame
+    volatile bool busy;        // Set by the trigger, cleared once the frame is published
+    volatile uint32_t overruns;
+    volatile uint32_t read_errors;
+    volatile uint32_t reader_retries;
+    volatile uint32_t last_skew_us;
+    volatile uint32_t max_skew_us;
+    volatile uint64_t total_skew_us;
+    volatile uint32_t max_duration_us;
+    volatile bool stop_requested;
+};
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_group_init_default_config(bno055_group_config_t *group_config);
+
+    esp_err_t bno055_group_start(const bno055_group_config_t *group_config, bno055_group_t *group);
+
+    esp_err_t bno055_group_stop(bno055_group_t *group);
+
+    esp_err_t bno055_group_read(bno055_group_t *group, bno055_group_frame_t *frame, int64_t *age_us);
+
+    esp_err_t bno055_group_get_stats(bno055_group_t *group, bno055_group_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
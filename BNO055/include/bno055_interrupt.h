@@ -0,0 +1,105 @@
+#ifndef _BNO055_INTERRUPT_H_
+#define _BNO055_INTERRUPT_H_
+
+#pragma once
+
+#include "freertos/queue.h"
+#include "esp_sleep.h"
+#include "esp_attr.h"
+#include "bno055.h"
+
+// Interrupt sources, the same bit in INT_MSK, INT_EN and INT_STA
+typedef enum bno055_interrupt_source_t
+{
+    GYRO_ANY_MOTION_INT = 0x04,
+    GYRO_HIGH_RATE_INT = 0x08,
+    ACC_HIGH_G_INT = 0x20,
+    ACC_ANY_MOTION_INT = 0x40,
+    ACC_NO_MOTION_INT = 0x80
+} bno055_interrupt_source_t;
+
+// Axis enable bits, shifted into place for each engine
+#define BNO055_AXIS_X 0x01
+#define BNO055_AXIS_Y 0x02
+#define BNO055_AXIS_Z 0x04
+#define BNO055_AXIS_ALL 0x07
+
+#define BNO055_INTERRUPT_TASK_STACK 3072
+
+typedef struct bno055_interrupt_event_t
+{
+    uint8_t status;       // INT_STA, bno055_interrupt_source_t bits
+    int64_t timestamp_us; // esp_timer time of the INT edge
+    uint32_t sequence;    // Event counter, gaps mean queue drops
+} bno055_interrupt_event_t;
+
+// Runs in the event task, so it may block briefly and use the bus
+typedef void (*bno055_interrupt_callback_t)(const bno055_interrupt_event_t *event, void *arg);
+
+// Register values are raw; the LSB sizes below are for the default ranges (accelerometer 4 g, gyroscope 2000 dps)
+typedef struct bno055_interrupt_config_t
+{
+    uint8_t sources;   // bno055_interrupt_source_t bits routed to the INT pin
+    gpio_num_t int_io; // GPIO connected to INT (active high, latched until reset)
+
+    uint8_t acc_motion_axes;          // Axes for any-motion and no-motion
+    uint8_t acc_any_motion_threshold; // ACC_AM_THRES, 7.81 mg LSB
+    uint8_t acc_any_motion_duration;  // Consecutive samples above threshold minus one, 0 - 3
+    uint8_t acc_no_motion_threshold;  // ACC_NM_THRES, 7.81 mg LSB
+    uint8_t acc_no_motion_duration;   // ACC_NM_SET duration field, 0 - 63 (1 s steps up to 16 s)
+    bool acc_slow_motion;             // Use slow-motion instead of no-motion detection
+
+    uint8_t acc_high_g_axes;
+    uint8_t acc_high_g_threshold; // ACC_HG_THRES, 15.63 mg LSB
+    uint8_t acc_high_g_duration;  // ACC_HG_DURATION, (value + 1) * 2 ms
+
+    uint8_t gyr_any_motion_axes;
+    uint8_t gyr_any_motion_threshold; // GYR_AM_THRES, 1 dps LSB
+    uint8_t gyr_any_motion_samples;   // Slope samples field, 0 - 3 (8 to 64 samples)
+    uint8_t gyr_any_motion_awake;     // Awake duration field, 0 - 3
+
+    uint8_t gyr_high_rate_axes;
+    uint8_t gyr_high_rate_threshold;  // GYR_HR_x_SET threshold, 0 - 31, 62.5 dps LSB
+    uint8_t gyr_high_rate_hysteresis; // GYR_HR_x_SET hysteresis, 0 - 3
+    uint8_t gyr_high_rate_duration;   // GYR_DUR_x, (value + 1) * 2.5 ms
+
+    QueueHandle_t queue; // Event queue (item size sizeof(bno055_interrupt_event_t)), or NULL
+    bno055_interrupt_callback_t callback; // Called from the event task, or NULL
+    void *callback_arg;
+    UBaseType_t task_priority;
+    bool light_sleep_wake; // Keep INT as a light-sleep wake-up source
+} bno055_interrupt_config_t;
+
+// Allocated by the caller, all fields are internal
+typedef struct bno055_interrupt_t
+{
+    i2c_master_dev_handle_t *slave_handle;
+    imu_t *imu;
+    gpio_num_t int_io;
+    QueueHandle_t queue;
+    bno055_interrupt_callback_t callback;
+    void *callback_arg;
+    TaskHandle_t task;
+    volatile int64_t timestamp_us;
+    volatile uint32_t events;
+    volatile uint32_t dropped;
+    volatile bool running;
+    bool light_sleep_wake;
+} bno055_interrupt_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_interrupt_init_default_config(bno055_interrupt_config_t *interrupt_config);
+
+    esp_err_t bno055_interrupt_start(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_interrupt_config_t *interrupt_config, bno055_interrupt_t *interrupt);
+
+    esp_err_t bno055_interrupt_stop(bno055_interrupt_t *interrupt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
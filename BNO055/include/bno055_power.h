@@ -0,0 +1,46 @@
+#ifndef _BNO055_POWER_H_
+#define _BNO055_POWER_H_
+
+#pragma once
+
+#include "bno055.h"
+
+// Register values are raw; the LSB sizes below are for the default accelerometer range (4 g)
+typedef struct bno055_power_config_t
+{
+    bno055_power_mode_t power_mode;
+
+    // Low power mode policy: sleep after no motion, wake up on any motion
+    uint8_t no_motion_threshold;   // ACC_NM_THRES, 7.81 mg LSB
+    uint16_t no_motion_duration_s; // Seconds without motion before the sensors sleep, 1 - 336
+    uint8_t any_motion_threshold;  // ACC_AM_THRES, 7.81 mg LSB
+
+    // Duty cycle of the sensors while asleep
+    uint8_t acc_sleep_duration;      // ACC_SLEEP_CONFIG duration field, 5 - 15 (0.5 ms to 1 s)
+    bool acc_equidistant_sampling;   // Sample at a fixed rate while asleep instead of event driven
+    uint8_t gyr_sleep_duration;      // GYR_SLEEP_CONFIG duration field, 0 - 7 (2 ms to 20 ms)
+    uint8_t gyr_auto_sleep_duration; // GYR_SLEEP_CONFIG auto sleep field, 1 - 7 (4 ms to 40 ms)
+} bno055_power_config_t;
+
+typedef struct bno055_wake_latency_t
+{
+    uint32_t transition_us;   // PWR_MODE write until SYS_STATUS reports the running mode, including any CONFIG round trip
+    uint32_t first_sample_us; // From the start of the wake-up until the first sample is read
+} bno055_wake_latency_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_power_init_default_config(bno055_power_config_t *power_config);
+
+    esp_err_t bno055_power_configure(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_power_config_t *power_config);
+
+    esp_err_t bno055_power_wake(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint16_t sensor_mask, bno055_wake_latency_t *latency);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
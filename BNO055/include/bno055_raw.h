@@ -0,0 +1,190 @@
+#ifndef _BNO055_RAW_H_
+#define _BNO055_RAW_H_
+
+#pragma once
+
+#include "bno055.h"
+
+// ACC_CONFIG
+typedef enum bno055_acc_range_t
+{
+    ACC_RANGE_2G = 0x00,
+    ACC_RANGE_4G = 0x01,
+    ACC_RANGE_8G = 0x02,
+    ACC_RANGE_16G = 0x03
+} bno055_acc_range_t;
+
+typedef enum bno055_acc_bandwidth_t
+{
+    ACC_BW_7_81HZ = 0x00,
+    ACC_BW_15_63HZ = 0x01,
+    ACC_BW_31_25HZ = 0x02,
+    ACC_BW_62_5HZ = 0x03,
+    ACC_BW_125HZ = 0x04,
+    ACC_BW_250HZ = 0x05,
+    ACC_BW_500HZ = 0x06,
+    ACC_BW_1000HZ = 0x07
+} bno055_acc_bandwidth_t;
+
+typedef enum bno055_acc_power_t
+{
+    ACC_PWR_NORMAL = 0x00,
+    ACC_PWR_SUSPEND = 0x01,
+    ACC_PWR_LOW_POWER_1 = 0x02,
+    ACC_PWR_STANDBY = 0x03,
+    ACC_PWR_LOW_POWER_2 = 0x04,
+    ACC_PWR_DEEP_SUSPEND = 0x05
+} bno055_acc_power_t;
+
+// MAG_CONFIG
+typedef enum bno055_mag_rate_t
+{
+    MAG_ODR_2HZ = 0x00,
+    MAG_ODR_6HZ = 0x01,
+    MAG_ODR_8HZ = 0x02,
+    MAG_ODR_10HZ = 0x03,
+    MAG_ODR_15HZ = 0x04,
+    MAG_ODR_20HZ = 0x05,
+    MAG_ODR_25HZ = 0x06,
+    MAG_ODR_30HZ = 0x07
+} bno055_mag_rate_t;
+
+typedef enum bno055_mag_operation_t
+{
+    MAG_OPR_LOW_POWER = 0x00,
+    MAG_OPR_REGULAR = 0x01,
+    MAG_OPR_ENHANCED_REGULAR = 0x02,
+    MAG_OPR_HIGH_ACCURACY = 0x03
+} bno055_mag_operation_t;
+
+typedef enum bno055_mag_power_t
+{
+    MAG_PWR_NORMAL = 0x00,
+    MAG_PWR_SLEEP = 0x01,
+    MAG_PWR_SUSPEND = 0x02,
+    MAG_PWR_FORCE = 0x03
+} bno055_mag_power_t;
+
+// GYR_CONFIG_0 and GYR_CONFIG_1
+typedef enum bno055_gyr_range_t
+{
+    GYR_RANGE_2000DPS = 0x00,
+    GYR_RANGE_1000DPS = 0x01,
+    GYR_RANGE_500DPS = 0x02,
+    GYR_RANGE_250DPS = 0x03,
+    GYR_RANGE_125DPS = 0x04
+} bno055_gyr_range_t;
+
+typedef enum bno055_gyr_bandwidth_t
+{
+    GYR_BW_523HZ = 0x00,
+    GYR_BW_230HZ = 0x01,
+    GYR_BW_116HZ = 0x02,
+    GYR_BW_47HZ = 0x03,
+    GYR_BW_23HZ = 0x04,
+    GYR_BW_12HZ = 0x05,
+    GYR_BW_64HZ = 0x06,
+    GYR_BW_32HZ = 0x07
+} bno055_gyr_bandwidth_t;
+
+typedef enum bno055_gyr_power_t
+{
+    GYR_PWR_NORMAL = 0x00,
+    GYR_PWR_FAST_POWER_UP = 0x01,
+    GYR_PWR_DEEP_SUSPEND = 0x02,
+    GYR_PWR_SUSPEND = 0x03,
+    GYR_PWR_ADVANCED_POWERSAVE = 0x04
+} bno055_gyr_power_t;
+
+// Only applied in the non-fusion modes; the fusion modes control the sensors themselves
+typedef struct bno055_sensor_settings_t
+{
+    bno055_acc_range_t acc_range;
+    bno055_acc_bandwidth_t acc_bandwidth;
+    bno055_acc_power_t acc_power;
+    bno055_mag_rate_t mag_rate;
+    bno055_mag_operation_t mag_operation;
+    bno055_mag_power_t mag_power;
+    bno055_gyr_range_t gyr_range;
+    bno055_gyr_bandwidth_t gyr_bandwidth;
+    bno055_gyr_power_t gyr_power;
+} bno055_sensor_settings_t;
+
+// One burst of data registers in chip counts; sensors outside the stream mask read as zero
+typedef struct bno055_raw_sample_t
+{
+    int16_t accel[3];
+    int16_t mag[3];
+    int16_t gyro[3];
+    int64_t timestamp_us; // esp_timer time at the end of the burst read
+} bno055_raw_sample_t;
+
+typedef struct bno055_raw_stream_config_t
+{
+    uint16_t sensor_mask; // Any of ACCELEROMETER_MASK, MAGNETOMETER_MASK and GYROSCOPE_MASK
+    uint32_t rate_hz;     // Paced by esp_timer, so not limited to the tick rate
+    bno055_raw_sample_t *buffer;
+    uint32_t capacity; // Samples in buffer, a power of two
+    UBaseType_t task_priority;
+    BaseType_t core_id; // Core the stream task is pinned to, or tskNO_AFFINITY
+} bno055_raw_stream_config_t;
+
+typedef struct bno055_raw_stream_stats_t
+{
+    uint32_t samples;     // Samples written to the ring
+    uint32_t overruns;    // Samples dropped because the ring was full
+    uint32_t missed;      // Timer periods skipped because the previous read was still running
+    uint32_t read_errors; // Failed bus reads
+    uint32_t max_read_us; // Longest bus time seen
+} bno055_raw_stream_stats_t;
+
+// Allocated by the caller, all fields are internal
+typedef struct bno055_raw_stream_t
+{
+    i2c_master_dev_handle_t *slave_handle;
+    imu_t *imu;
+    bno055_read_span_t span;
+    uint16_t sensor_mask;
+    bno055_raw_sample_t *buffer;
+    uint32_t index_mask;
+    esp_timer_handle_t timer;
+    TaskHandle_t task;
+    volatile uint32_t head; // Written by the stream task only
+    volatile uint32_t tail; // Written by the reader only
+    volatile uint32_t overruns;
+    volatile uint32_t missed;
+    volatile uint32_t read_errors;
+    volatile uint32_t max_read_us;
+    volatile bool stop_requested;
+    volatile bool running;
+} bno055_raw_stream_t;
+
+#define BNO055_RAW_STREAM_TASK_STACK 3072
+#define BNO055_RAW_STREAM_MAX_RATE_HZ 2000
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_set_sensor_settings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_sensor_settings_t *settings);
+
+    esp_err_t bno055_get_sensor_settings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_sensor_settings_t *settings);
+
+    esp_err_t bno055_raw_stream_init_default_config(bno055_raw_stream_config_t *stream_config);
+
+    esp_err_t bno055_raw_stream_start(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_raw_stream_config_t *stream_config, bno055_raw_stream_t *stream);
+
+    esp_err_t bno055_raw_stream_stop(bno055_raw_stream_t *stream);
+
+    size_t bno055_raw_stream_read(bno055_raw_stream_t *stream, bno055_raw_sample_t *samples, size_t max_samples);
+
+    esp_err_t bno055_raw_stream_get_stats(bno055_raw_stream_t *stream, bno055_raw_stream_stats_t *stats);
+
+    void bno055_raw_sample_to_vectors(const imu_t *imu, const bno055_raw_sample_t *sample, vector_t *accel, vector_t *mag, vector_t *gyro);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
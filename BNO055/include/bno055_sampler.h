@@ -0,0 +1,83 @@
+#ifndef _BNO055_SAMPLER_H_
+#define _BNO055_SAMPLER_H_
+
+#pragma once
+
+#include "bno055.h"
+
+#define BNO055_SAMPLER_TASK_STACK 4096
+
+typedef struct bno055_sampler_config_t
+{
+    uint16_t sensor_mask; // bno055_sensor_mask_t bits read every period
+    uint32_t period_ms;   // Sampling period, 10 ms matches the 100 Hz fusion rate
+    UBaseType_t task_priority;
+    BaseType_t core_id; // Core the sampler task is pinned to, or tskNO_AFFINITY
+} bno055_sampler_config_t;
+
+// One published sample; only the outputs in the sensor mask are updated
+typedef struct bno055_snapshot_t
+{
+    vector_t raw_acceleration;
+    vector_t gyroscope;
+    vector_t magnetometer;
+    vector_t euler_angles;
+    quaternion_t quaternion;
+    vector_t linear_acceleration;
+    vector_t gravity;
+    float temperature;
+    uint8_t calibration_status;
+    int64_t timestamp_us; // esp_timer time at the end of the burst read
+    uint32_t sequence;    // Sample number, starting at 1
+} bno055_snapshot_t;
+
+typedef struct bno055_sampler_stats_t
+{
+    uint32_t samples;        // Snapshots published
+    uint32_t overruns;       // Periods where the read did not finish before the next deadline
+    uint32_t read_errors;    // Failed bus reads, the previous snapshot stays published
+    uint32_t reader_retries; // Reader copies repeated because a write was in progress
+    uint32_t last_read_us;   // Bus time of the last read
+    uint32_t max_read_us;    // Longest bus time seen
+} bno055_sampler_stats_t;
+
+// Allocated by the caller, all fields are internal
+typedef struct bno055_sampler_t
+{
+    i2c_master_dev_handle_t *slave_handle;
+    imu_t *imu;
+    bno055_read_plan_t plan;
+    TickType_t period;
+    TaskHandle_t task;
+    portMUX_TYPE write_lock;
+    volatile uint32_t seqlock; // Odd while the snapshot is being written
+    bno055_snapshot_t snapshot;
+    volatile uint32_t overruns;
+    volatile uint32_t read_errors;
+    volatile uint32_t reader_retries;
+    volatile uint32_t last_read_us;
+    volatile uint32_t max_read_us;
+    volatile bool stop_requested;
+    volatile bool running;
+} bno055_sampler_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_sampler_init_default_config(bno055_sampler_config_t *sampler_config);
+
+    esp_err_t bno055_sampler_start(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_sampler_config_t *sampler_config, bno055_sampler_t *sampler);
+
+    esp_err_t bno055_sampler_stop(bno055_sampler_t *sampler);
+
+    esp_err_t bno055_sampler_read(bno055_sampler_t *sampler, bno055_snapshot_t *snapshot, int64_t *age_us);
+
+    esp_err_t bno055_sampler_get_stats(bno055_sampler_t *sampler, bno055_sampler_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
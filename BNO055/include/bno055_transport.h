@@ -0,0 +1,86 @@
+#ifndef _BNO055_TRANSPORT_H_
+#define _BNO055_TRANSPORT_H_
+
+#pragma once
+
+#include <stdbool.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "driver/i2c_master.h"
+#include "driver/uart.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#define BNO055_I2C_TIMEOUT_MS 1000
+#define BNO055_UART_TIMEOUT_MS 50
+#define BNO055_UART_BAUD_RATE 115200
+#define BNO055_UART_RX_BUFFER_SIZE 256
+#define BNO055_UART_QUEUE_SIZE 16
+#define BNO055_UART_RETRIES 3
+
+// UART framing, datasheet 4.7
+#define BNO055_UART_START_BYTE 0xAA
+#define BNO055_UART_WRITE 0x00
+#define BNO055_UART_READ 0x01
+#define BNO055_UART_READ_RESPONSE 0xBB
+#define BNO055_UART_STATUS_RESPONSE 0xEE
+#define BNO055_UART_WRITE_SUCCESS 0x01
+#define BNO055_UART_BUS_OVER_RUN_ERROR 0x07
+#define BNO055_UART_MAX_LENGTH 128
+
+typedef enum bno055_transport_type_t
+{
+    I2C_TRANSPORT, // Default, slave_handle is used
+    UART_TRANSPORT // PS1 high, slave_handle is ignored
+} bno055_transport_type_t;
+
+typedef struct bno055_uart_config_t
+{
+    uart_port_t port;
+    gpio_num_t tx_io;
+    gpio_num_t rx_io;
+    uint32_t timeout_ms; // Per transaction, 0 for BNO055_UART_TIMEOUT_MS
+} bno055_uart_config_t;
+
+typedef struct bno055_transport_stats_t
+{
+    uint32_t transactions; // Completed reads and writes
+    uint32_t errors;       // Failed reads and writes, after retries
+    uint32_t retries;      // UART transactions repeated after a bus over-run
+    uint32_t bytes;        // Register bytes moved
+    uint64_t total_us;     // Time spent in transactions
+    uint32_t max_us;       // Longest transaction
+} bno055_transport_stats_t;
+
+// Zero initialised, this is the I2C transport with the default timeout
+typedef struct bno055_transport_t
+{
+    bno055_transport_type_t type;
+    uint32_t timeout_ms; // 0 for the default of the transport
+    uart_port_t uart_port;
+    QueueHandle_t uart_queue;
+    bno055_transport_stats_t stats;
+} bno055_transport_t;
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    esp_err_t bno055_transport_uart_init(bno055_transport_t *transport, const bno055_uart_config_t *uart_config);
+
+    esp_err_t bno055_transport_uart_deinit(bno055_transport_t *transport);
+
+    esp_err_t bno055_transport_read(i2c_master_dev_handle_t *slave_handle, bno055_transport_t *transport, uint8_t register_address, uint8_t *register_content, size_t length, uint32_t timeout_ms);
+
+    esp_err_t bno055_transport_write(i2c_master_dev_handle_t *slave_handle, bno055_transport_t *transport, uint8_t register_address, const uint8_t *register_content, size_t length, uint32_t timeout_ms);
+
+    void bno055_transport_reset_stats(bno055_transport_t *transport);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
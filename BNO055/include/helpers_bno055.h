@@ -6,6 +6,7 @@
 #ifndef LOG_LOCAL_LEVEL
 #define LOG_LOCAL_LEVEL ESP_LOG_VERBOSE
 #endif
+#include <stdbool.h>
 #include "esp_log.h"
 #include "esp_err.h"
 #include "driver/gpio.h"
@@ -25,6 +26,12 @@ typedef struct quaternion_t
     float w;
 } quaternion_t;
 
+// Row-major, rotates sensor frame vectors into the world frame
+typedef struct rotation_matrix_t
+{
+    float m[3][3];
+} rotation_matrix_t;
+
 typedef struct offset_t
 {
     vector_t accel;
@@ -40,15 +47,23 @@ typedef struct scale_t
     float mag;
     float temp;
     float quat;
+    float accel_range; // Full scale of the configured range, in the accelerometer units
+    float gyro_range;  // Full scale of the configured range, in the gyroscope units
 } scale_t;
 
 typedef struct sensor_config_t
 {
     offset_t offsets;
     float accel_radius;
-    float gyro_radius;
+    float gyro_radius; // The BNO055 has no gyroscope radius register, unused
+    float mag_radius;
+    uint8_t accel_range_g;   // ACC_CONFIG range, 0 means the 4 g reset default
+    uint16_t gyro_range_dps; // GYR_CONFIG_0 range, 0 means the 2000 dps reset default
     scale_t sensor_scale;
     gpio_num_t reset_io;
+    uint8_t axis_map_config; // AXIS_MAP_CONFIG written again after every reset, 0 keeps the P1 default
+    uint8_t axis_map_sign;   // AXIS_MAP_SIGN written with it
+    const char *calibration_key; // NVS key of the calibration profile restored by bno055_startup(), or NULL
 } sensor_config_t;
 
 #ifdef __cplusplus
@@ -56,11 +71,19 @@ extern "C"
 {
 #endif
 
-    int signum(double value);
+    int signum(float value);
+
+    float absolute(float value);
+
+    int quotient(float dividend, float divisor);
+
+    float fast_atan2f(float y, float x);
+
+    void quaternion_to_euler(const quaternion_t *quaternion, bool radians, bool windows_orientation, vector_t *euler_angles);
 
-    double absolute(double value);
+    void quaternion_to_gravity(const quaternion_t *quaternion, float magnitude, vector_t *gravity);
 
-    int quotient(double dividend, double divisor);
+    void quaternion_to_rotation_matrix(const quaternion_t *quaternion, rotation_matrix_t *rotation_matrix);
 
 #ifdef __cplusplus
 }
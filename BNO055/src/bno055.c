@@ -1,166 +1,367 @@
+#include <string.h>
 #include "bno055.h"
+#include "bno055_calibration.h"
 
-esp_err_t set_page(i2c_master_dev_handle_t *slave_handle, uint8_t page)
+void bno055_invalidate_state(imu_t *imu)
 {
-    uint8_t register_address, register_content = 0x00;
+    if (imu != NULL)
+        imu->state.valid = 0;
+}
+
+static void create_lock(imu_t *imu)
+{
+    // Called from the setup functions, before any other task can use the device
+    if (imu != NULL && imu->lock == NULL)
+        imu->lock = xSemaphoreCreateRecursiveMutexStatic(&imu->lock_buffer);
+}
+
+void bno055_lock(imu_t *imu)
+{
+    if (imu != NULL && imu->lock != NULL)
+        xSemaphoreTakeRecursive(imu->lock, portMAX_DELAY);
+}
+
+void bno055_unlock(imu_t *imu)
+{
+    if (imu != NULL && imu->lock != NULL)
+        xSemaphoreGiveRecursive(imu->lock);
+}
 
-    // Reading page id register
-    register_address = PAGE_ID;
-    esp_err_t ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content, sizeof(register_content), pdMS_TO_TICKS(1000));
+static esp_err_t read_registers(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t register_address, uint8_t *register_content, size_t length)
+{
+    esp_err_t ret = bno055_transport_read(slave_handle, &imu->transport, register_address, register_content, length, 0);
     if (ret != ESP_OK)
     {
-        ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
+        // The device may have reset or missed a write, so nothing cached can be trusted
+        bno055_invalidate_state(imu);
+        ESP_LOGE("BNO_BUS", "Failed to read %d bytes from register '0x%x'. Error: %s", (int)length, register_address, esp_err_to_name(ret));
         return ret;
     }
 
-    // Check if already in same page
-    if (register_content == page)
-    {
-        ESP_LOGV("BNO_CONFIG", "Already in page: '%d'", page);
-        return ESP_OK;
-    }
+    return ESP_OK;
+}
+
+static esp_err_t write_registers(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t register_address, const uint8_t *register_content, size_t length)
+{
+    if (length > BNO055_MAX_WRITE_LENGTH)
+        return ESP_ERR_INVALID_SIZE;
 
-    // Setting page id
-    uint8_t write_buffer[2] = {register_address, page};
-    ret = i2c_master_transmit(*slave_handle, write_buffer, sizeof(write_buffer), pdMS_TO_TICKS(1000));
+    esp_err_t ret = bno055_transport_write(slave_handle, &imu->transport, register_address, register_content, length, 0);
     if (ret != ESP_OK)
     {
-        ESP_LOGE("I2C", "Failed to write to register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
+        bno055_invalidate_state(imu);
+        ESP_LOGE("BNO_BUS", "Failed to write to register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
         return ret;
     }
 
     return ESP_OK;
 }
 
-esp_err_t set_external_crystal_use(i2c_master_dev_handle_t *slave_handle, bool state)
+static esp_err_t write_register(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t register_address, uint8_t register_content)
 {
-    uint8_t register_address, register_content = 0x00;
+    return write_registers(slave_handle, imu, register_address, &register_content, sizeof(register_content));
+}
 
-    // Set page to 0
-    set_page(slave_handle, 0);
+static void poll_delay(void)
+{
+    TickType_t ticks = pdMS_TO_TICKS(BNO055_POLL_INTERVAL_MS);
+    vTaskDelay(ticks > 0 ? ticks : 1);
+}
 
-    // Reading operation mode
-    register_address = OPR_MODE;
-    esp_err_t ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content, sizeof(register_content), pdMS_TO_TICKS(1000));
-    if (ret != ESP_OK)
+static esp_err_t poll_register(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t register_address, uint8_t mask, uint8_t expected, uint32_t timeout_ms, uint8_t *register_content)
+{
+    int64_t start = esp_timer_get_time();
+
+    while (1)
     {
-        ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
-        return ret;
+        // NACKs and missing UART responses are expected while the device boots, so bus errors only mean "not ready yet"
+        esp_err_t ret = bno055_transport_read(slave_handle, &imu->transport, register_address, register_content, 1, BNO055_POLL_BUS_TIMEOUT_MS);
+        if (ret == ESP_OK && (*register_content & mask) == expected)
+            return ESP_OK;
+
+        if (esp_timer_get_time() - start >= (int64_t)timeout_ms * 1000)
+        {
+            ESP_LOGE("BNO_CONFIG", "Timed out after %d ms waiting for register '0x%x' to read '0x%x' (last '0x%x')", (int)timeout_ms, register_address, expected, *register_content);
+            return ESP_ERR_TIMEOUT;
+        }
+
+        poll_delay();
     }
+}
+
+static esp_err_t wait_for_system_status(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t system_status, uint32_t timeout_ms)
+{
+    uint8_t register_content = 0x00;
 
-    if ((register_content & 0x0f) != CONFIG_MODE)
+    esp_err_t ret = poll_register(slave_handle, imu, SYS_STATUS, 0xff, system_status, timeout_ms, &register_content);
+    if (ret != ESP_OK)
     {
-        ESP_LOGE("BNO_CONFIG", "Cannot set external crystal usage in non configuration modes. Current mode: %d", register_content & 0x0f);
-        return ESP_ERR_INVALID_STATE;
+        bno055_invalidate_state(imu);
+
+        if (register_content == BNO055_SYS_STATUS_ERROR && read_registers(slave_handle, imu, SYS_ERR, &register_content, sizeof(register_content)) == ESP_OK)
+        {
+            ESP_LOGE("BNO_CONFIG", "System error: '0x%x'", register_content);
+            return ESP_FAIL;
+        }
     }
 
-    register_address = SYS_TRIGGER;
-    ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content, sizeof(register_content), pdMS_TO_TICKS(1000));
+    return ret;
+}
+
+static esp_err_t wait_for_boot(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    uint8_t register_content = 0x00;
+
+    // CHIP_ID answers once the boot loader has handed over, then the system settles in idle
+    esp_err_t ret = poll_register(slave_handle, imu, CHIP_ID, 0xff, BNO055_CHIP_ID, BNO055_BOOT_TIMEOUT_MS, &register_content);
     if (ret != ESP_OK)
-    {
-        ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
         return ret;
+
+    return wait_for_system_status(slave_handle, imu, BNO055_SYS_STATUS_IDLE, BNO055_BOOT_TIMEOUT_MS);
+}
+
+esp_err_t set_page(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t page)
+{
+    // Check if already in same page
+    if ((imu->state.valid & BNO055_STATE_PAGE) && imu->state.page == page)
+    {
+        ESP_LOGV("BNO_CONFIG", "Already in page: '%d'", page);
+        return ESP_OK;
     }
 
-    register_content = (register_content & ~0x80) | (state ? 0x80 : 0x00);
-    uint8_t write_buffer[2] = {register_address, register_content};
-    ret = i2c_master_transmit(*slave_handle, write_buffer, sizeof(write_buffer), pdMS_TO_TICKS(1000));
+    // Setting page id, PAGE_ID is mapped on both pages so no read-back is needed
+    esp_err_t ret = write_register(slave_handle, imu, PAGE_ID, page);
     if (ret != ESP_OK)
-    {
-        ESP_LOGE("I2C", "Failed to write to register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
         return ret;
-    }
 
-    vTaskDelay(pdMS_TO_TICKS(650));
+    imu->state.page = page;
+    imu->state.valid |= BNO055_STATE_PAGE;
     return ESP_OK;
 }
 
-esp_err_t set_operation_mode(i2c_master_dev_handle_t *slave_handle, bno055_operation_mode_t operation_mode)
+static esp_err_t get_operation_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t *operation_mode)
 {
-    uint8_t register_address, register_content = 0x00;
-
-    // Reading operation mode
-    register_address = OPR_MODE;
-    esp_err_t ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content, sizeof(register_content), pdMS_TO_TICKS(1000));
-    if (ret != ESP_OK)
+    if (imu->state.valid & BNO055_STATE_OPR_MODE)
     {
-        ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
-        return ret;
+        *operation_mode = imu->state.operation_mode;
+        return ESP_OK;
     }
 
-    // Check if already in same mode
-    if ((register_content & 0x0f) == operation_mode)
-        return ESP_OK;
+    // OPR_MODE is a page 0 register
+    esp_err_t ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
 
-    // Setting operation mode
-    register_content = (register_content & ~0x0f) | operation_mode;
-    uint8_t write_buffer[2] = {register_address, register_content};
-    ret = i2c_master_transmit(*slave_handle, write_buffer, sizeof(write_buffer), pdMS_TO_TICKS(1000));
+    uint8_t register_content = 0x00;
+    ret = read_registers(slave_handle, imu, OPR_MODE, &register_content, sizeof(register_content));
     if (ret != ESP_OK)
-    {
-        ESP_LOGE("I2C", "Failed to write to register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
         return ret;
-    }
 
-    vTaskDelay(pdMS_TO_TICKS(50));
+    imu->state.operation_mode = register_content & 0x0f;
+    imu->state.valid |= BNO055_STATE_OPR_MODE;
+    *operation_mode = imu->state.operation_mode;
     return ESP_OK;
 }
 
-esp_err_t set_units(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t units_selected)
+esp_err_t set_external_crystal_use(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bool state)
 {
-    uint8_t register_address, register_content = 0x00;
+    bno055_operation_mode_t operation_mode;
 
-    ESP_LOGV("BNO_CONFIG", "Setting units to: '%d'", units_selected);
-    // Reading operation mode
-    register_address = OPR_MODE;
-    esp_err_t ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content, sizeof(register_content), pdMS_TO_TICKS(1000));
-    if (ret != ESP_OK)
+    // Check if already using the same clock source
+    if ((imu->state.valid & BNO055_STATE_CRYSTAL) && imu->state.external_crystal == state)
     {
-        ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
-        return ret;
+        ESP_LOGV("BNO_CONFIG", "External crystal already %s", state ? "in use" : "unused");
+        return ESP_OK;
     }
 
-    // Check if not in config mode
-    if ((register_content & 0x0f) != CONFIG_MODE)
+    esp_err_t ret = get_operation_mode(slave_handle, imu, &operation_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    if (operation_mode != CONFIG_MODE)
+    {
+        ESP_LOGE("BNO_CONFIG", "Cannot set external crystal usage in non configuration modes. Current mode: %d", operation_mode);
         return ESP_ERR_INVALID_STATE;
+    }
 
-    ESP_LOGV("BNO_CONFIG", " BNO is in config mode, will set page 0");
     // Set page to 0
-    ret = set_page(slave_handle, 0);
+    ret = set_page(slave_handle, imu, 0);
     if (ret != ESP_OK)
-    {
-        ESP_LOGE("BNO_CONFIG", "Failed to set page 0. Error: %s", esp_err_to_name(ret));
         return ret;
-    }
 
-    ESP_LOGV("BNO_CONFIG", " BNO is page 0, will check units");
-    // Check if already in same units
-    register_address = UNIT_SEL;
-    ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content, sizeof(register_content), pdMS_TO_TICKS(1000));
+    // The clock source can only be changed while ST_MAIN_CLK reports it free
+    uint8_t register_content = 0x00;
+    ret = poll_register(slave_handle, imu, SYS_CLK_STATUS, 0x01, 0x00, BNO055_CLOCK_TIMEOUT_MS, &register_content);
     if (ret != ESP_OK)
-    {
-        ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
         return ret;
-    }
 
-    if ((register_content & 0x9f) == units_selected)
+    // The other SYS_TRIGGER bits are self-clearing triggers that read back as 0
+    ret = write_register(slave_handle, imu, SYS_TRIGGER, state ? 0x80 : 0x00);
+    if (ret != ESP_OK)
+        return ret;
+
+    // Wait for the switch to finish instead of sleeping a fixed 650 ms
+    ret = poll_register(slave_handle, imu, SYS_CLK_STATUS, 0x01, 0x00, BNO055_CLOCK_TIMEOUT_MS, &register_content);
+    if (ret != ESP_OK)
+        return ret;
+
+    imu->state.external_crystal = state;
+    imu->state.valid |= BNO055_STATE_CRYSTAL;
+    return ESP_OK;
+}
+
+static uint8_t mode_system_status(bno055_operation_mode_t operation_mode)
+{
+    // SYS_STATUS reported once the mode is running
+    switch (operation_mode)
     {
-        ESP_LOGV("BNO_CONFIG", "Already in units: '%d'", units_selected);
+    case CONFIG_MODE:
+        return BNO055_SYS_STATUS_IDLE;
+
+    case IMU_MODE:
+    case COMPASS_MODE:
+    case M4G_MODE:
+    case NDOF_FMC_OFF_MODE:
+    case NDOF_MODE:
+        return BNO055_SYS_STATUS_FUSION;
+
+    default:
+        return BNO055_SYS_STATUS_NO_FUSION;
     }
-    else
+}
+
+esp_err_t set_operation_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode)
+{
+    esp_err_t ret;
+    bno055_operation_mode_t current_mode;
+
+    // Check if already in same mode
+    if ((imu->state.valid & BNO055_STATE_OPR_MODE) && imu->state.operation_mode == operation_mode)
+        return ESP_OK;
+
+    // Switching between two running modes goes through CONFIG, so SYS_STATUS tells when each step is done
+    if (operation_mode != CONFIG_MODE)
     {
-        ESP_LOGV("BNO_CONFIG", " BNO has different units, will set units");
-        // Setting units
-        register_content = (register_content & ~0x9f) | units_selected;
-        uint8_t write_buffer[2] = {register_address, register_content};
-        ret = i2c_master_transmit(*slave_handle, write_buffer, sizeof(write_buffer), pdMS_TO_TICKS(1000));
+        ret = get_operation_mode(slave_handle, imu, &current_mode);
         if (ret != ESP_OK)
-        {
-            ESP_LOGE("I2C", "Failed to write to register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
             return ret;
+
+        if (current_mode == operation_mode)
+            return ESP_OK;
+
+        if (current_mode != CONFIG_MODE)
+        {
+            ret = set_operation_mode(slave_handle, imu, CONFIG_MODE);
+            if (ret != ESP_OK)
+                return ret;
         }
     }
 
+    // OPR_MODE is a page 0 register
+    ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    // Setting operation mode, the upper bits are reserved
+    ret = write_register(slave_handle, imu, OPR_MODE, operation_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    // Datasheet switching time is 19 ms into CONFIG and 7 ms out of it, poll rather than sleep a fixed 50 ms
+    ret = wait_for_system_status(slave_handle, imu, mode_system_status(operation_mode), operation_mode == CONFIG_MODE ? BNO055_TO_CONFIG_TIMEOUT_MS : BNO055_FROM_CONFIG_TIMEOUT_MS);
+    if (ret != ESP_OK)
+        return ret;
+
+    imu->state.operation_mode = operation_mode;
+    imu->state.valid = (imu->state.valid | BNO055_STATE_OPR_MODE) & ~BNO055_STATE_RESUME_MODE;
+    return ESP_OK;
+}
+
+static esp_err_t enter_config_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t *previous_mode)
+{
+    // Remember the running mode so it can be restored after the CONFIG-only writes
+    esp_err_t ret = get_operation_mode(slave_handle, imu, previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    return set_operation_mode(slave_handle, imu, CONFIG_MODE);
+}
+
+esp_err_t bno055_read_registers(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t page, uint8_t register_address, uint8_t *register_content, size_t length)
+{
+    if (imu == NULL || register_content == NULL || length == 0)
+        return ESP_ERR_INVALID_ARG;
+
+    // The page switch and the transfer belong together, another task must not move the page in between
+    bno055_lock(imu);
+    esp_err_t ret = set_page(slave_handle, imu, page);
+    if (ret == ESP_OK)
+        ret = read_registers(slave_handle, imu, register_address, register_content, length);
+    bno055_unlock(imu);
+
+    return ret;
+}
+
+esp_err_t bno055_write_registers(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t page, uint8_t register_address, const uint8_t *register_content, size_t length)
+{
+    if (imu == NULL || register_content == NULL || length == 0)
+        return ESP_ERR_INVALID_ARG;
+
+    bno055_lock(imu);
+    esp_err_t ret = set_page(slave_handle, imu, page);
+    if (ret == ESP_OK)
+        ret = write_registers(slave_handle, imu, register_address, register_content, length);
+    bno055_unlock(imu);
+
+    return ret;
+}
+
+esp_err_t bno055_enter_config_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t *previous_mode)
+{
+    if (imu == NULL || previous_mode == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    bno055_lock(imu);
+    esp_err_t ret = enter_config_mode(slave_handle, imu, previous_mode);
+    bno055_unlock(imu);
+    return ret;
+}
+
+static esp_err_t reset_interrupts(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    uint8_t register_content = 0x00;
+
+    if (imu == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    // SYS_TRIGGER also holds CLK_SEL, which must be written back unchanged
+    if ((imu->state.valid & BNO055_STATE_CRYSTAL) == 0)
+    {
+        ret = read_registers(slave_handle, imu, SYS_TRIGGER, &register_content, sizeof(register_content));
+        if (ret != ESP_OK)
+            return ret;
+
+        imu->state.external_crystal = (register_content & 0x80) != 0;
+        imu->state.valid |= BNO055_STATE_CRYSTAL;
+    }
+
+    return write_register(slave_handle, imu, SYS_TRIGGER, 0x40 | (imu->state.external_crystal ? 0x80 : 0x00));
+}
+
+esp_err_t bno055_reset_interrupts(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    bno055_lock(imu);
+    esp_err_t ret = reset_interrupts(slave_handle, imu);
+    bno055_unlock(imu);
+    return ret;
+}
+
+static void set_sensor_scale(imu_t *imu, uint8_t units_selected)
+{
     switch (units_selected & 0x01)
     {
     case ACC_MG:
@@ -204,35 +405,81 @@ esp_err_t set_units(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t u
     imu->bno055_config.sensor_scale.mag = 16.0f; // magnetometer is always in uT
     imu->bno055_config.sensor_scale.quat = 16384.0f;
 
-    return ESP_OK;
+    // The data registers keep the same LSB in every range, only the full scale follows it
+    float accel_range_g = imu->bno055_config.accel_range_g ? imu->bno055_config.accel_range_g : 4.0f;
+    float gyro_range_dps = imu->bno055_config.gyro_range_dps ? imu->bno055_config.gyro_range_dps : 2000.0f;
+
+    imu->bno055_config.sensor_scale.accel_range = accel_range_g * ((units_selected & ACC_MG) ? BNO055_GRAVITY_MG : BNO055_GRAVITY_M_S2);
+    imu->bno055_config.sensor_scale.gyro_range = gyro_range_dps * ((units_selected & GY_RPS) ? ((float)M_PI / 180.0f) : 1.0f);
 }
 
-esp_err_t bno055_initialize(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+void bno055_refresh_sensor_scale(imu_t *imu)
 {
-    uint8_t register_address, register_content = 0x00;
+    if (imu->state.valid & BNO055_STATE_UNITS)
+        set_sensor_scale(imu, imu->state.units);
+}
 
-    // Reading chip ID register
-    register_address = CHIP_ID;
-    esp_err_t ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content, sizeof(register_content), pdMS_TO_TICKS(1000));
+esp_err_t set_units(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t units_selected)
+{
+    uint8_t register_content = 0x00;
+    bno055_operation_mode_t operation_mode;
+
+    ESP_LOGV("BNO_CONFIG", "Setting units to: '%d'", units_selected);
+
+    // Check if already in same units, the scale factors are refreshed either way
+    if ((imu->state.valid & BNO055_STATE_UNITS) && imu->state.units == units_selected)
+    {
+        ESP_LOGV("BNO_CONFIG", "Already in units: '%d'", units_selected);
+        set_sensor_scale(imu, units_selected);
+        return ESP_OK;
+    }
+
+    // Check if not in config mode
+    esp_err_t ret = get_operation_mode(slave_handle, imu, &operation_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    if (operation_mode != CONFIG_MODE)
+        return ESP_ERR_INVALID_STATE;
+
+    ESP_LOGV("BNO_CONFIG", " BNO is in config mode, will set page 0");
+    // Set page to 0
+    ret = set_page(slave_handle, imu, 0);
     if (ret != ESP_OK)
     {
-        ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
+        ESP_LOGE("BNO_CONFIG", "Failed to set page 0. Error: %s", esp_err_to_name(ret));
         return ret;
     }
 
-    switch (register_content)
-    {
-    case 0xA0:
-        ESP_LOGD("BNO_CONFIG", "Verified BNO055 chip ID '0x%x'", register_content);
-        break;
+    ESP_LOGV("BNO_CONFIG", " BNO is page 0, will check units");
+    ret = read_registers(slave_handle, imu, UNIT_SEL, &register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
 
-    default:
-        ESP_LOGE("BNO_CONFIG", "Invalid chip ID: '0x%x'", register_content);
-        return ESP_ERR_INVALID_MAC;
+    if ((register_content & 0x9f) == units_selected)
+    {
+        ESP_LOGV("BNO_CONFIG", "Already in units: '%d'", units_selected);
     }
+    else
+    {
+        ESP_LOGV("BNO_CONFIG", " BNO has different units, will set units");
+        // Setting units, keeping the reserved bits
+        ret = write_register(slave_handle, imu, UNIT_SEL, (register_content & ~0x9f) | units_selected);
+        if (ret != ESP_OK)
+            return ret;
+    }
+
+    imu->state.units = units_selected;
+    imu->state.valid |= BNO055_STATE_UNITS;
+    set_sensor_scale(imu, units_selected);
+
+    return ESP_OK;
+}
 
+static esp_err_t configure_reset_pin(imu_t *imu)
+{
     // Configuring reset pin and setting high
-    ret = gpio_set_direction(imu->bno055_config.reset_io, GPIO_MODE_OUTPUT);
+    esp_err_t ret = gpio_set_direction(imu->bno055_config.reset_io, GPIO_MODE_OUTPUT);
     if (ret != ESP_OK)
         return ret;
 
@@ -240,35 +487,67 @@ esp_err_t bno055_initialize(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
     if (ret != ESP_OK)
         return ret;
 
-    ret = gpio_set_level(imu->bno055_config.reset_io, 1);
+    return gpio_set_level(imu->bno055_config.reset_io, 1);
+}
+
+static esp_err_t initialize(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    uint8_t register_content = 0x00;
+
+    // Nothing is known about a device that has not been initialized yet
+    bno055_invalidate_state(imu);
+
+    // Reading chip ID register
+    esp_err_t ret = read_registers(slave_handle, imu, CHIP_ID, &register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    switch (register_content)
+    {
+    case BNO055_CHIP_ID:
+        ESP_LOGD("BNO_CONFIG", "Verified BNO055 chip ID '0x%x'", register_content);
+        break;
+
+    default:
+        ESP_LOGE("BNO_CONFIG", "Invalid chip ID: '0x%x'", register_content);
+        return ESP_ERR_INVALID_MAC;
+    }
+
+    ret = configure_reset_pin(imu);
     if (ret != ESP_OK)
         return ret;
 
     // Set page to 0
-    ret = set_page(slave_handle, 0);
+    ret = set_page(slave_handle, imu, 0);
     if (ret != ESP_OK)
         return ret;
 
-    // Setting operation mode register to config mode - 0b0000
-    ret = set_operation_mode(slave_handle, CONFIG_MODE);
+    // Setting operation mode register to config mode - 0b0000, returns once the device reports idle
+    return set_operation_mode(slave_handle, imu, CONFIG_MODE);
+}
 
-    vTaskDelay(pdMS_TO_TICKS(50));
+esp_err_t bno055_initialize(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    create_lock(imu);
+    bno055_lock(imu);
+    esp_err_t ret = initialize(slave_handle, imu);
+    bno055_unlock(imu);
     return ret;
 }
 
-esp_err_t bno055_configure(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode, uint8_t units_selected)
+static esp_err_t configure(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode, uint8_t units_selected)
 {
     esp_err_t ret;
 
-    ESP_LOGV("BNO_CONFIG", "Setting external crystal.");
-    // Setting the external crystal to be used
-    ret = set_external_crystal_use(slave_handle, 1);
+    ESP_LOGV("BNO_CONFIG", "Setting operation mode to config.");
+    // Set operation mode config, the crystal and units can only change in it
+    ret = set_operation_mode(slave_handle, imu, CONFIG_MODE);
     if (ret != ESP_OK)
         return ret;
 
-    ESP_LOGV("BNO_CONFIG", "Setting operation mode to config.");
-    // Set operation mode config
-    ret = set_operation_mode(slave_handle, CONFIG_MODE);
+    ESP_LOGV("BNO_CONFIG", "Setting external crystal.");
+    // Setting the external crystal to be used
+    ret = set_external_crystal_use(slave_handle, imu, 1);
     if (ret != ESP_OK)
         return ret;
 
@@ -279,7 +558,7 @@ esp_err_t bno055_configure(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bn
         return ret;
 
     // Set it to required operation mode - NDOF parameter (for PW)
-    ret = set_operation_mode(slave_handle, operation_mode);
+    ret = set_operation_mode(slave_handle, imu, operation_mode);
     if (ret != ESP_OK)
         return ret;
 
@@ -287,78 +566,154 @@ esp_err_t bno055_configure(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bn
     return ret;
 }
 
-esp_err_t bno055_calibration_status(i2c_master_dev_handle_t *slave_handle)
+esp_err_t bno055_configure(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode, uint8_t units_selected)
 {
-    // Reading calibration status register
-    uint8_t register_address = CALIB_STAT, register_content = 0x00;
-    esp_err_t ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content, sizeof(register_content), pdMS_TO_TICKS(1000));
-    if (ret != ESP_OK)
-    {
-        ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
-        return ret;
-    }
+    bno055_lock(imu);
+    esp_err_t ret = configure(slave_handle, imu, operation_mode, units_selected);
+    bno055_unlock(imu);
+    return ret;
+}
+
+static esp_err_t startup(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode, uint8_t units_selected, bno055_startup_timing_t *timing)
+{
+    bno055_startup_timing_t phases = {0};
+    int64_t start = esp_timer_get_time(), phase_start = start;
+
+    // Hardware reset, then poll until the device answers and reports idle
+    esp_err_t ret = configure_reset_pin(imu);
+    if (ret == ESP_OK)
+        ret = bno055_reset(slave_handle, imu);
+    phases.boot_us = esp_timer_get_time() - phase_start;
+
+    if (ret == ESP_OK)
+    {
+        phase_start = esp_timer_get_time();
+        ret = bno055_initialize(slave_handle, imu);
+        phases.config_us = esp_timer_get_time() - phase_start;
+    }
+
+    if (ret == ESP_OK)
+    {
+        phase_start = esp_timer_get_time();
+        ret = set_external_crystal_use(slave_handle, imu, 1);
+        phases.crystal_us = esp_timer_get_time() - phase_start;
+    }
+
+    if (ret == ESP_OK)
+    {
+        phase_start = esp_timer_get_time();
+        ret = set_units(slave_handle, imu, units_selected);
+        phases.units_us = esp_timer_get_time() - phase_start;
+    }
+
+    // Stored offsets go in while still in CONFIG, before fusion starts
+    if (ret == ESP_OK && imu->bno055_config.calibration_key != NULL)
+    {
+        phase_start = esp_timer_get_time();
+        ret = bno055_restore_calibration(slave_handle, imu, imu->bno055_config.calibration_key);
+        if (ret == ESP_ERR_NVS_NOT_FOUND || ret == ESP_ERR_INVALID_VERSION)
+        {
+            ESP_LOGW("BNO_CONFIG", "No usable calibration profile '%s', the device calibrates from scratch", imu->bno055_config.calibration_key);
+            ret = ESP_OK;
+        }
+        phases.calibration_us = esp_timer_get_time() - phase_start;
+    }
+
+    if (ret == ESP_OK)
+    {
+        phase_start = esp_timer_get_time();
+        ret = set_operation_mode(slave_handle, imu, operation_mode);
+        phases.mode_us = esp_timer_get_time() - phase_start;
+    }
+
+    phases.total_us = esp_timer_get_time() - start;
+    if (timing != NULL)
+        *timing = phases;
 
-    ESP_LOGV("BNO_SENSOR", "Calibration status - Acc: %d, Gyro: %d, Mag: %d, Sys: %d", (register_content & 0x0c) / 4, (register_content & 0x30) / 16, (register_content & 0x03), (register_content & 0xc0) / 64);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE("BNO_CONFIG", "Startup failed after %lld us. Error: %s", (long long)phases.total_us, esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGI("BNO_CONFIG", "Started in %lld us (boot %lld, config %lld, crystal %lld, units %lld, calibration %lld, mode %lld)", (long long)phases.total_us, (long long)phases.boot_us, (long long)phases.config_us, (long long)phases.crystal_us, (long long)phases.units_us, (long long)phases.calibration_us, (long long)phases.mode_us);
     return ESP_OK;
 }
 
-esp_err_t bno055_get_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_sensor_t sensor)
+esp_err_t bno055_startup(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode, uint8_t units_selected, bno055_startup_timing_t *timing)
+{
+    create_lock(imu);
+    bno055_lock(imu);
+    esp_err_t ret = startup(slave_handle, imu, operation_mode, units_selected, timing);
+    bno055_unlock(imu);
+    return ret;
+}
+
+esp_err_t bno055_set_operation_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_operation_mode_t operation_mode)
+{
+    if (imu == NULL || operation_mode > NDOF_MODE)
+        return ESP_ERR_INVALID_ARG;
+
+    bno055_lock(imu);
+    esp_err_t ret = set_operation_mode(slave_handle, imu, operation_mode);
+    bno055_unlock(imu);
+    return ret;
+}
+
+// Output sensors in register order; the index is the bit in bno055_sensor_mask_t
+static const bno055_sensor_t output_sensors[] = {ACCELEROMETER, MAGNETOMETER, GYROSCOPE, EULER_ANGLE, QUATERNION, LINEAR_ACCELERATION, GRAVITY, TEMPERATURE};
+
+static uint8_t sensor_length(bno055_sensor_t sensor)
 {
-    esp_err_t ret;
-    uint8_t register_address = sensor, register_content[8] = {0}, reg_count;
     switch (sensor)
     {
     case QUATERNION:
-        reg_count = 8;
-        break;
+        return 8;
 
     case TEMPERATURE:
-        reg_count = 1;
-        break;
+        return 1;
+
+    case ACCELEROMETER:
+    case MAGNETOMETER:
+    case GYROSCOPE:
+    case EULER_ANGLE:
+    case LINEAR_ACCELERATION:
+    case GRAVITY:
+        return 6;
 
     default:
-        reg_count = 6;
-        break;
+        return 0;
     }
+}
 
-    for (size_t i = 0; i < reg_count; i++)
-    {
-        ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content[i], sizeof(register_content[i]), pdMS_TO_TICKS(1000));
-        if (ret != ESP_OK)
-        {
-            ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
-            return ret;
-        }
-        register_address++;
-    }
+static void decode_vector(const uint8_t *register_content, float scale, vector_t *vector)
+{
+    vector->x = (int16_t)((register_content[1] << 8) | register_content[0]) / scale;
+    vector->y = (int16_t)((register_content[3] << 8) | register_content[2]) / scale;
+    vector->z = (int16_t)((register_content[5] << 8) | register_content[4]) / scale;
+}
 
+static esp_err_t decode_readings(imu_t *imu, bno055_sensor_t sensor, const uint8_t *register_content)
+{
     switch (sensor)
     {
     case ACCELEROMETER:
-        imu->raw_acceleration.x = (int16_t)((register_content[1] << 8) | register_content[0]) / imu->bno055_config.sensor_scale.accel;
-        imu->raw_acceleration.y = (int16_t)((register_content[3] << 8) | register_content[2]) / imu->bno055_config.sensor_scale.accel;
-        imu->raw_acceleration.z = (int16_t)((register_content[5] << 8) | register_content[4]) / imu->bno055_config.sensor_scale.accel;
+        decode_vector(register_content, imu->bno055_config.sensor_scale.accel, &imu->raw_acceleration);
         ESP_LOGV("BNO_SENSOR", "Acceleration vector - X: %.3f, Y: %.3f, Z: %.3f", imu->raw_acceleration.x, imu->raw_acceleration.y, imu->raw_acceleration.z);
         break;
 
     case MAGNETOMETER:
-        imu->magnetometer.x = (int16_t)((register_content[1] << 8) | register_content[0]) / imu->bno055_config.sensor_scale.mag;
-        imu->magnetometer.y = (int16_t)((register_content[3] << 8) | register_content[2]) / imu->bno055_config.sensor_scale.mag;
-        imu->magnetometer.z = (int16_t)((register_content[5] << 8) | register_content[4]) / imu->bno055_config.sensor_scale.mag;
+        decode_vector(register_content, imu->bno055_config.sensor_scale.mag, &imu->magnetometer);
         ESP_LOGV("BNO_SENSOR", "Magnetometer vector - X: %.3f, Y: %.3f, Z: %.3f", imu->magnetometer.x, imu->magnetometer.y, imu->magnetometer.z);
         break;
 
     case GYROSCOPE:
-        imu->gyroscope.x = (int16_t)((register_content[1] << 8) | register_content[0]) / imu->bno055_config.sensor_scale.gyro;
-        imu->gyroscope.y = (int16_t)((register_content[3] << 8) | register_content[2]) / imu->bno055_config.sensor_scale.gyro;
-        imu->gyroscope.z = (int16_t)((register_content[5] << 8) | register_content[4]) / imu->bno055_config.sensor_scale.gyro;
+        decode_vector(register_content, imu->bno055_config.sensor_scale.gyro, &imu->gyroscope);
         ESP_LOGV("BNO_SENSOR", "Gyroscope vector - X: %.3f, Y: %.3f, Z: %.3f", imu->gyroscope.x, imu->gyroscope.y, imu->gyroscope.z);
         break;
 
     case EULER_ANGLE:
-        imu->euler_angles.x = (int16_t)((register_content[1] << 8) | register_content[0]) / imu->bno055_config.sensor_scale.euler;
-        imu->euler_angles.y = (int16_t)((register_content[3] << 8) | register_content[2]) / imu->bno055_config.sensor_scale.euler;
-        imu->euler_angles.z = (int16_t)((register_content[5] << 8) | register_content[4]) / imu->bno055_config.sensor_scale.euler;
+        decode_vector(register_content, imu->bno055_config.sensor_scale.euler, &imu->euler_angles);
         ESP_LOGV("BNO_SENSOR", "Euler vector - Yaw: %.3f, Pitch: %.3f, Roll: %.3f", imu->euler_angles.x, imu->euler_angles.y, imu->euler_angles.z);
         break;
 
@@ -371,16 +726,12 @@ esp_err_t bno055_get_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu,
         break;
 
     case LINEAR_ACCELERATION:
-        imu->linear_acceleration.x = (int16_t)((register_content[1] << 8) | register_content[0]) / imu->bno055_config.sensor_scale.accel;
-        imu->linear_acceleration.y = (int16_t)((register_content[3] << 8) | register_content[2]) / imu->bno055_config.sensor_scale.accel;
-        imu->linear_acceleration.z = (int16_t)((register_content[5] << 8) | register_content[4]) / imu->bno055_config.sensor_scale.accel;
+        decode_vector(register_content, imu->bno055_config.sensor_scale.accel, &imu->linear_acceleration);
         ESP_LOGV("BNO_SENSOR", "Linear acceleration vector - X: %.3f, Y: %.3f, Z: %.3f", imu->linear_acceleration.x, imu->linear_acceleration.y, imu->linear_acceleration.z);
         break;
 
     case GRAVITY:
-        imu->gravity.x = (int16_t)((register_content[1] << 8) | register_content[0]) / imu->bno055_config.sensor_scale.accel;
-        imu->gravity.y = (int16_t)((register_content[3] << 8) | register_content[2]) / imu->bno055_config.sensor_scale.accel;
-        imu->gravity.z = (int16_t)((register_content[5] << 8) | register_content[4]) / imu->bno055_config.sensor_scale.accel;
+        decode_vector(register_content, imu->bno055_config.sensor_scale.accel, &imu->gravity);
         ESP_LOGV("BNO_SENSOR", "Gravity vector - X: %.3f, Y: %.3f, Z: %.3f", imu->gravity.x, imu->gravity.y, imu->gravity.z);
         break;
 
@@ -397,60 +748,635 @@ esp_err_t bno055_get_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu,
     return ESP_OK;
 }
 
-esp_err_t bno055_get_offsets(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+static esp_err_t get_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_sensor_t sensor)
 {
-    esp_err_t ret;
-    uint8_t register_address = ACC_OFFSET_X_LSB, register_content[18];
-    for (size_t i = 0; i < 6; i++)
+    uint8_t register_content[8] = {0}, reg_count = sensor_length(sensor);
+    if (reg_count == 0)
     {
-        ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), &register_content[i], sizeof(register_content[i]), pdMS_TO_TICKS(1000));
+        ESP_LOGE("BNO_SENSOR", "Invalid sensor type");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Output registers are on page 0, free when the page is cached
+    esp_err_t ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = read_registers(slave_handle, imu, sensor, register_content, reg_count);
+    if (ret != ESP_OK)
+        return ret;
+
+    return decode_readings(imu, sensor, register_content);
+}
+
+esp_err_t bno055_get_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_sensor_t sensor)
+{
+    bno055_lock(imu);
+    esp_err_t ret = get_readings(slave_handle, imu, sensor);
+    bno055_unlock(imu);
+    return ret;
+}
+
+static void decode_calibration_status(imu_t *imu, uint8_t register_content)
+{
+    imu->calibration_status = register_content;
+    ESP_LOGV("BNO_SENSOR", "Calibration status - Acc: %d, Gyro: %d, Mag: %d, Sys: %d", (imu->calibration_status & 0x0c) / 4, (imu->calibration_status & 0x30) / 16, (imu->calibration_status & 0x03), (imu->calibration_status & 0xc0) / 64);
+}
+
+static esp_err_t get_calibration_status(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    uint8_t register_content = 0x00;
+
+    if (imu == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // Reading calibration status register
+    esp_err_t ret = bno055_read_registers(slave_handle, imu, 0, CALIB_STAT, &register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    decode_calibration_status(imu, register_content);
+    return ESP_OK;
+}
+
+esp_err_t bno055_get_calibration_status(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    bno055_lock(imu);
+    esp_err_t ret = get_calibration_status(slave_handle, imu);
+    bno055_unlock(imu);
+    return ret;
+}
+
+esp_err_t bno055_calibration_status(i2c_master_dev_handle_t *slave_handle)
+{
+    // Without an imu_t the device can only be an I2C one with nothing cached
+    imu_t imu = {0};
+    return bno055_get_calibration_status(slave_handle, &imu);
+}
+
+static esp_err_t get_all_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    uint8_t register_content[BNO055_OUTPUT_BURST_LENGTH] = {0};
+
+    esp_err_t ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    // One transaction for every output instead of one per sensor
+    ret = read_registers(slave_handle, imu, ACC_DATA_X_LSB, register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    // Sensor enum values are register addresses, so they index straight into the burst
+    for (size_t i = 0; i < sizeof(output_sensors) / sizeof(output_sensors[0]); i++)
+    {
+        ret = decode_readings(imu, output_sensors[i], &register_content[output_sensors[i] - ACC_DATA_X_LSB]);
         if (ret != ESP_OK)
-        {
-            ESP_LOGE("I2C", "Failed to read from register '0x%x'. Error: %s", register_address, esp_err_to_name(ret));
             return ret;
+    }
+
+    decode_calibration_status(imu, register_content[CALIB_STAT - ACC_DATA_X_LSB]);
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_get_all_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    bno055_lock(imu);
+    esp_err_t ret = get_all_readings(slave_handle, imu);
+    bno055_unlock(imu);
+    return ret;
+}
+
+uint16_t bno055_sensor_to_mask(bno055_sensor_t sensor)
+{
+    for (size_t i = 0; i < sizeof(output_sensors) / sizeof(output_sensors[0]); i++)
+    {
+        if (output_sensors[i] == sensor)
+            return 1 << i;
+    }
+
+    return 0;
+}
+
+esp_err_t bno055_plan_readings(uint16_t sensor_mask, uint8_t transaction_overhead, bno055_read_plan_t *plan)
+{
+    if (plan == NULL || sensor_mask == 0 || (sensor_mask & ~ALL_SENSORS_MASK) != 0)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(plan, 0, sizeof(bno055_read_plan_t));
+    plan->sensor_mask = sensor_mask;
+
+    // Walk the outputs in register order, then calibration status right after temperature
+    for (size_t i = 0; i <= sizeof(output_sensors) / sizeof(output_sensors[0]); i++)
+    {
+        if ((sensor_mask & (1 << i)) == 0)
+            continue;
+
+        uint8_t start = (i < sizeof(output_sensors) / sizeof(output_sensors[0])) ? output_sensors[i] : CALIB_STAT;
+        uint8_t length = (i < sizeof(output_sensors) / sizeof(output_sensors[0])) ? sensor_length(output_sensors[i]) : 1;
+
+        if (plan->span_count > 0)
+        {
+            bno055_read_span_t *last = &plan->spans[plan->span_count - 1];
+            uint8_t gap = start - (last->register_address + last->length);
+
+            // Reading the unused gap is cheaper than addressing a new transaction
+            if (gap < transaction_overhead || gap == 0)
+            {
+                last->length += gap + length;
+                continue;
+            }
         }
-        register_address++;
+
+        plan->spans[plan->span_count].register_address = start;
+        plan->spans[plan->span_count].length = length;
+        plan->span_count++;
     }
 
-    imu->bno055_config.offsets.accel.x = (int16_t)((register_content[1] << 8) | register_content[0]) / imu->bno055_config.sensor_scale.accel;
-    imu->bno055_config.offsets.accel.y = (int16_t)((register_content[3] << 8) | register_content[2]) / imu->bno055_config.sensor_scale.accel;
-    imu->bno055_config.offsets.accel.z = (int16_t)((register_content[5] << 8) | register_content[4]) / imu->bno055_config.sensor_scale.accel;
+    for (size_t i = 0; i < plan->span_count; i++)
+        plan->data_bytes += plan->spans[i].length;
+    plan->bus_bytes = plan->data_bytes + plan->span_count * transaction_overhead;
+
+    ESP_LOGD("BNO_SENSOR", "Read plan for mask '0x%x': %d transactions, %d data bytes, %d bus bytes", sensor_mask, plan->span_count, plan->data_bytes, plan->bus_bytes);
+    return ESP_OK;
+}
+
+static bool valid_plan(const bno055_read_plan_t *plan)
+{
+    if (plan->span_count > BNO055_MAX_READ_SPANS || (plan->sensor_mask & ~ALL_SENSORS_MASK) != 0)
+        return false;
+
+    // Plans can be built or edited by hand, every span has to land inside the output burst
+    for (size_t i = 0; i < plan->span_count; i++)
+    {
+        if (plan->spans[i].length == 0 || plan->spans[i].register_address < ACC_DATA_X_LSB || plan->spans[i].register_address + plan->spans[i].length > CALIB_STAT + 1)
+            return false;
+    }
+
+    return true;
+}
+
+static esp_err_t get_planned_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_read_plan_t *plan)
+{
+    esp_err_t ret;
+    uint8_t register_content[BNO055_OUTPUT_BURST_LENGTH] = {0};
+
+    if (plan == NULL || imu == NULL || !valid_plan(plan))
+        return ESP_ERR_INVALID_ARG;
+
+    ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    // Each span lands at its register offset, so decoding does not depend on the plan shape
+    for (size_t i = 0; i < plan->span_count; i++)
+    {
+        ret = read_registers(slave_handle, imu, plan->spans[i].register_address, &register_content[plan->spans[i].register_address - ACC_DATA_X_LSB], plan->spans[i].length);
+        if (ret != ESP_OK)
+            return ret;
+    }
+
+    // Only the requested outputs are decoded, merged gap bytes are ignored
+    for (size_t i = 0; i < sizeof(output_sensors) / sizeof(output_sensors[0]); i++)
+    {
+        if ((plan->sensor_mask & (1 << i)) == 0)
+            continue;
+
+        ret = decode_readings(imu, output_sensors[i], &register_content[output_sensors[i] - ACC_DATA_X_LSB]);
+        if (ret != ESP_OK)
+            return ret;
+    }
+
+    if (plan->sensor_mask & CALIBRATION_STATUS_MASK)
+        decode_calibration_status(imu, register_content[CALIB_STAT - ACC_DATA_X_LSB]);
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_get_planned_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_read_plan_t *plan)
+{
+    bno055_lock(imu);
+    esp_err_t ret = get_planned_readings(slave_handle, imu, plan);
+    bno055_unlock(imu);
+    return ret;
+}
+
+esp_err_t bno055_get_sensor_readings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint16_t sensor_mask)
+{
+    bno055_read_plan_t plan;
+
+    esp_err_t ret = bno055_plan_readings(sensor_mask, BNO055_TRANSACTION_OVERHEAD_BYTES, &plan);
+    if (ret != ESP_OK)
+        return ret;
+
+    return bno055_get_planned_readings(slave_handle, imu, &plan);
+}
+
+void bno055_derive_orientation(imu_t *imu)
+{
+    bool radians = imu->bno055_config.sensor_scale.euler == 900.0f;
+    bool windows_orientation = (imu->state.valid & BNO055_STATE_UNITS) && (imu->state.units & ORI_WINDOWS);
+    float gravity = (imu->bno055_config.sensor_scale.accel == 1.0f) ? BNO055_GRAVITY_MG : BNO055_GRAVITY_M_S2;
+
+    // Same units and conventions as the chip's own EUL and GRV registers
+    quaternion_to_euler(&imu->quaternion, radians, windows_orientation, &imu->euler_angles);
+    quaternion_to_gravity(&imu->quaternion, gravity, &imu->gravity);
+    quaternion_to_rotation_matrix(&imu->quaternion, &imu->rotation_matrix);
+}
+
+static esp_err_t get_orientation(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    // 8 quaternion bytes instead of 20 for quaternion, Euler angles and gravity
+    esp_err_t ret = bno055_get_readings(slave_handle, imu, QUATERNION);
+    if (ret != ESP_OK)
+        return ret;
+
+    bno055_derive_orientation(imu);
+    ESP_LOGV("BNO_SENSOR", "Derived Euler vector - Yaw: %.3f, Pitch: %.3f, Roll: %.3f", imu->euler_angles.x, imu->euler_angles.y, imu->euler_angles.z);
+    return ESP_OK;
+}
+
+esp_err_t bno055_get_orientation(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    // The derivation reads the quaternion back from imu_t, so it stays under the same lock as the read
+    bno055_lock(imu);
+    esp_err_t ret = get_orientation(slave_handle, imu);
+    bno055_unlock(imu);
+    return ret;
+}
+
+static esp_err_t get_calibration_profile(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_calibration_profile_t *profile)
+{
+    if (imu == NULL || profile == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    // Offsets and radii in one burst
+    return read_registers(slave_handle, imu, ACC_OFFSET_X_LSB, profile->data, sizeof(profile->data));
+}
+
+esp_err_t bno055_get_calibration_profile(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_calibration_profile_t *profile)
+{
+    bno055_lock(imu);
+    esp_err_t ret = get_calibration_profile(slave_handle, imu, profile);
+    bno055_unlock(imu);
+    return ret;
+}
+
+static esp_err_t set_calibration_profile(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_calibration_profile_t *profile)
+{
+    bno055_operation_mode_t previous_mode;
+
+    if (imu == NULL || profile == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // The offset registers are only writable in CONFIG mode
+    esp_err_t ret = enter_config_mode(slave_handle, imu, &previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = write_registers(slave_handle, imu, ACC_OFFSET_X_LSB, profile->data, sizeof(profile->data));
+    if (ret != ESP_OK)
+        return ret;
+
+    return set_operation_mode(slave_handle, imu, previous_mode);
+}
+
+esp_err_t bno055_set_calibration_profile(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_calibration_profile_t *profile)
+{
+    bno055_lock(imu);
+    esp_err_t ret = set_calibration_profile(slave_handle, imu, profile);
+    bno055_unlock(imu);
+    return ret;
+}
+
+static float decode_offset(const uint8_t *register_content, float scale)
+{
+    return (int16_t)((register_content[1] << 8) | register_content[0]) / scale;
+}
+
+static void encode_offset(uint8_t *register_content, float value, float scale)
+{
+    float counts = roundf(value * scale);
+
+    // Clamp to the 16-bit register range
+    if (counts > INT16_MAX)
+        counts = INT16_MAX;
+    else if (counts < INT16_MIN)
+        counts = INT16_MIN;
+
+    int16_t raw = (int16_t)counts;
+    register_content[0] = (uint16_t)raw & 0xff;
+    register_content[1] = ((uint16_t)raw >> 8) & 0xff;
+}
+
+esp_err_t bno055_get_offsets(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    bno055_calibration_profile_t profile;
+
+    esp_err_t ret = bno055_get_calibration_profile(slave_handle, imu, &profile);
+    if (ret != ESP_OK)
+        return ret;
+
+    // Offsets follow the selected units, radii are raw LSB
+    imu->bno055_config.offsets.accel.x = decode_offset(&profile.data[0], imu->bno055_config.sensor_scale.accel);
+    imu->bno055_config.offsets.accel.y = decode_offset(&profile.data[2], imu->bno055_config.sensor_scale.accel);
+    imu->bno055_config.offsets.accel.z = decode_offset(&profile.data[4], imu->bno055_config.sensor_scale.accel);
     ESP_LOGV("BNO_SENSOR", "Accel offset vector - X: %.3f, Y: %.3f, Z: %.3f", imu->bno055_config.offsets.accel.x, imu->bno055_config.offsets.accel.y, imu->bno055_config.offsets.accel.z);
 
-    imu->bno055_config.offsets.mag.x = (int16_t)((register_content[7] << 8) | register_content[6]) / imu->bno055_config.sensor_scale.mag;
-    imu->bno055_config.offsets.mag.y = (int16_t)((register_content[9] << 8) | register_content[8]) / imu->bno055_config.sensor_scale.mag;
-    imu->bno055_config.offsets.mag.z = (int16_t)((register_content[11] << 8) | register_content[10]) / imu->bno055_config.sensor_scale.mag;
+    imu->bno055_config.offsets.mag.x = decode_offset(&profile.data[6], imu->bno055_config.sensor_scale.mag);
+    imu->bno055_config.offsets.mag.y = decode_offset(&profile.data[8], imu->bno055_config.sensor_scale.mag);
+    imu->bno055_config.offsets.mag.z = decode_offset(&profile.data[10], imu->bno055_config.sensor_scale.mag);
     ESP_LOGV("BNO_SENSOR", "Mag offset vector - X: %.3f, Y: %.3f, Z: %.3f", imu->bno055_config.offsets.mag.x, imu->bno055_config.offsets.mag.y, imu->bno055_config.offsets.mag.z);
 
-    imu->bno055_config.offsets.gyro.x = (int16_t)((register_content[13] << 8) | register_content[12]) / imu->bno055_config.sensor_scale.gyro;
-    imu->bno055_config.offsets.gyro.y = (int16_t)((register_content[15] << 8) | register_content[14]) / imu->bno055_config.sensor_scale.gyro;
-    imu->bno055_config.offsets.gyro.z = (int16_t)((register_content[17] << 8) | register_content[16]) / imu->bno055_config.sensor_scale.gyro;
+    imu->bno055_config.offsets.gyro.x = decode_offset(&profile.data[12], imu->bno055_config.sensor_scale.gyro);
+    imu->bno055_config.offsets.gyro.y = decode_offset(&profile.data[14], imu->bno055_config.sensor_scale.gyro);
+    imu->bno055_config.offsets.gyro.z = decode_offset(&profile.data[16], imu->bno055_config.sensor_scale.gyro);
     ESP_LOGV("BNO_SENSOR", "Gyro offset vector - X: %.3f, Y: %.3f, Z: %.3f", imu->bno055_config.offsets.gyro.x, imu->bno055_config.offsets.gyro.y, imu->bno055_config.offsets.gyro.z);
 
+    imu->bno055_config.accel_radius = decode_offset(&profile.data[18], 1.0f);
+    imu->bno055_config.mag_radius = decode_offset(&profile.data[20], 1.0f);
+    ESP_LOGV("BNO_SENSOR", "Radius - Accel: %.0f, Mag: %.0f", imu->bno055_config.accel_radius, imu->bno055_config.mag_radius);
+
     return ESP_OK;
 }
 
 esp_err_t bno055_set_offsets(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
 {
+    bno055_calibration_profile_t profile;
+
+    if (imu == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    encode_offset(&profile.data[0], imu->bno055_config.offsets.accel.x, imu->bno055_config.sensor_scale.accel);
+    encode_offset(&profile.data[2], imu->bno055_config.offsets.accel.y, imu->bno055_config.sensor_scale.accel);
+    encode_offset(&profile.data[4], imu->bno055_config.offsets.accel.z, imu->bno055_config.sensor_scale.accel);
+    encode_offset(&profile.data[6], imu->bno055_config.offsets.mag.x, imu->bno055_config.sensor_scale.mag);
+    encode_offset(&profile.data[8], imu->bno055_config.offsets.mag.y, imu->bno055_config.sensor_scale.mag);
+    encode_offset(&profile.data[10], imu->bno055_config.offsets.mag.z, imu->bno055_config.sensor_scale.mag);
+    encode_offset(&profile.data[12], imu->bno055_config.offsets.gyro.x, imu->bno055_config.sensor_scale.gyro);
+    encode_offset(&profile.data[14], imu->bno055_config.offsets.gyro.y, imu->bno055_config.sensor_scale.gyro);
+    encode_offset(&profile.data[16], imu->bno055_config.offsets.gyro.z, imu->bno055_config.sensor_scale.gyro);
+    encode_offset(&profile.data[18], imu->bno055_config.accel_radius, 1.0f);
+    encode_offset(&profile.data[20], imu->bno055_config.mag_radius, 1.0f);
+
+    return bno055_set_calibration_profile(slave_handle, imu, &profile);
+}
+
+static esp_err_t write_axis_map(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t axis_remap, uint8_t axis_sign)
+{
+    uint8_t register_content[AXIS_MAP_SIGN - AXIS_MAP_CONFIG + 1] = {axis_remap, axis_sign};
+    uint8_t read_back[sizeof(register_content)];
+
+    esp_err_t ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = write_registers(slave_handle, imu, AXIS_MAP_CONFIG, register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    // The device silently keeps the previous map when it rejects a value, so read it back
+    ret = read_registers(slave_handle, imu, AXIS_MAP_CONFIG, read_back, sizeof(read_back));
+    if (ret != ESP_OK)
+        return ret;
+
+    if ((read_back[0] & 0x3f) != register_content[0] || (read_back[1] & 0x07) != register_content[1])
+    {
+        imu->state.valid &= ~BNO055_STATE_AXIS_MAP;
+        ESP_LOGE("BNO_CONFIG", "Axis map '0x%x' sign '0x%x' was not accepted (reads '0x%x' '0x%x')", register_content[0], register_content[1], read_back[0], read_back[1]);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    imu->state.valid |= BNO055_STATE_AXIS_MAP;
+    ESP_LOGD("BNO_CONFIG", "Axis map '0x%x' sign '0x%x' applied", register_content[0], register_content[1]);
     return ESP_OK;
 }
 
-esp_err_t bno055_reset(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+static esp_err_t reset(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
 {
+    // The device comes back in its power-on state, whatever was cached is stale
+    bno055_invalidate_state(imu);
+
     esp_err_t ret = gpio_set_level(imu->bno055_config.reset_io, 0);
     if (ret != ESP_OK)
         return ret;
-    vTaskDelay(pdMS_TO_TICKS(100));
+
+    // nRESET only needs a short low pulse, the boot time is polled below
+    esp_rom_delay_us(BNO055_RESET_PULSE_US);
     ret = gpio_set_level(imu->bno055_config.reset_io, 1);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = wait_for_boot(slave_handle, imu);
+    if (ret != ESP_OK)
+        return ret;
+
+    // The remap is back at P1 after a reset, the device boots in CONFIG so it can be written straight away
+    if (imu->bno055_config.axis_map_config != 0)
+        ret = write_axis_map(slave_handle, imu, imu->bno055_config.axis_map_config, imu->bno055_config.axis_map_sign);
+
+    return ret;
+}
+
+esp_err_t bno055_reset(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
+{
+    create_lock(imu);
+    bno055_lock(imu);
+    esp_err_t ret = reset(slave_handle, imu);
+    bno055_unlock(imu);
+    return ret;
+}
+
+static bool valid_axis_map(uint8_t axis_remap, uint8_t axis_sign)
+{
+    uint8_t x_source = axis_remap & 0x03, y_source = (axis_remap >> 2) & 0x03, z_source = (axis_remap >> 4) & 0x03;
+
+    // Each remapped axis takes a different source axis, so the three fields are a permutation of X, Y and Z
+    return (axis_remap & 0xc0) == 0 && (axis_sign & 0xf8) == 0 &&
+           x_source != 0x03 && y_source != 0x03 && z_source != 0x03 &&
+           x_source != y_source && y_source != z_source && x_source != z_source;
+}
+
+static esp_err_t set_axis(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t axis_remap, uint8_t axis_sign)
+{
+    bno055_operation_mode_t previous_mode;
+
+    if (imu == NULL || !valid_axis_map(axis_remap, axis_sign))
+        return ESP_ERR_INVALID_ARG;
+
+    if ((imu->state.valid & BNO055_STATE_AXIS_MAP) && imu->bno055_config.axis_map_config == axis_remap && imu->bno055_config.axis_map_sign == axis_sign)
+    {
+        ESP_LOGV("BNO_CONFIG", "Already in axis map: '0x%x' sign '0x%x'", axis_remap, axis_sign);
+        return ESP_OK;
+    }
+
+    // The remap registers are only written in CONFIG mode, the running mode is restored afterwards
+    esp_err_t ret = enter_config_mode(slave_handle, imu, &previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = write_axis_map(slave_handle, imu, axis_remap, axis_sign);
+    if (ret != ESP_OK)
+    {
+        // Leave the device running as before, the write error is the one reported
+        (void)set_operation_mode(slave_handle, imu, previous_mode);
+        return ret;
+    }
+
+    // Kept in the configuration once applied, so bno055_reset() and bno055_startup() apply it again
+    imu->bno055_config.axis_map_config = axis_remap;
+    imu->bno055_config.axis_map_sign = axis_sign;
+
+    return set_operation_mode(slave_handle, imu, previous_mode);
+}
+
+esp_err_t bno055_set_axis(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint8_t axis_remap, uint8_t axis_sign)
+{
+    bno055_lock(imu);
+    esp_err_t ret = set_axis(slave_handle, imu, axis_remap, axis_sign);
+    bno055_unlock(imu);
+    return ret;
+}
+
+esp_err_t bno055_set_axis_placement(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_axis_placement_t placement)
+{
+    return bno055_set_axis(slave_handle, imu, (placement >> 8) & 0xff, placement & 0xff);
+}
+
+static esp_err_t get_power_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_power_mode_t *power_mode)
+{
+    uint8_t register_content = 0x00;
+
+    if (imu->state.valid & BNO055_STATE_POWER_MODE)
+    {
+        *power_mode = imu->state.power_mode;
+        return ESP_OK;
+    }
+
+    esp_err_t ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = read_registers(slave_handle, imu, PWR_MODE, &register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    imu->state.power_mode = register_content & 0x03;
+    imu->state.valid |= BNO055_STATE_POWER_MODE;
+    *power_mode = imu->state.power_mode;
     return ESP_OK;
 }
 
-esp_err_t bno055_set_axis(i2c_master_dev_handle_t *slave_handle, uint8_t axis_remap, uint8_t axis_sign)
+static esp_err_t wait_for_wake(i2c_master_dev_handle_t *slave_handle, imu_t *imu)
 {
+    uint8_t register_content = 0x00;
+    bool resume = imu->state.valid & BNO055_STATE_RESUME_MODE;
+    bno055_operation_mode_t resume_mode = imu->state.operation_mode;
+
+    // Any answer will do, OPR_MODE is read back once the device responds again
+    esp_err_t ret = poll_register(slave_handle, imu, OPR_MODE, 0x00, 0x00, BNO055_FROM_SUSPEND_TIMEOUT_MS, &register_content);
+    if (ret != ESP_OK)
+        return ret;
+
+    imu->state.operation_mode = register_content & 0x0f;
+    imu->state.valid = (imu->state.valid | BNO055_STATE_OPR_MODE) & ~BNO055_STATE_RESUME_MODE;
+
+    // The sensors restart before SYS_STATUS reports the mode running again
+    ret = wait_for_system_status(slave_handle, imu, mode_system_status(imu->state.operation_mode), BNO055_FROM_SUSPEND_TIMEOUT_MS);
+    if (ret != ESP_OK)
+        return ret;
+
+    // The mode written on the way into suspend did not take, write it again now that it can be verified
+    if (resume && imu->state.operation_mode != resume_mode)
+    {
+        ESP_LOGW("BNO_CONFIG", "Woke up in mode '%d' instead of '%d'", imu->state.operation_mode, resume_mode);
+        return set_operation_mode(slave_handle, imu, resume_mode);
+    }
+
     return ESP_OK;
 }
 
-esp_err_t bno055_power_mode_set(i2c_master_dev_handle_t *slave_handle, bno055_power_mode_t power_mode)
+static esp_err_t set_power_mode(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_power_mode_t power_mode)
 {
+    bno055_power_mode_t current_mode;
+    bno055_operation_mode_t previous_mode;
+
+    if (imu == NULL || power_mode > SUSPEND_MODE)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = get_power_mode(slave_handle, imu, &current_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    if (current_mode == power_mode)
+    {
+        ESP_LOGV("BNO_CONFIG", "Already in power mode: '%d'", power_mode);
+        return ESP_OK;
+    }
+
+    // The register map is frozen in suspend, so SYS_STATUS can only be polled after PWR_MODE is written back to normal
+    if (current_mode == SUSPEND_MODE)
+    {
+        ret = set_page(slave_handle, imu, 0);
+        if (ret != ESP_OK)
+            return ret;
+
+        ret = write_register(slave_handle, imu, PWR_MODE, NORMAL_MODE);
+        if (ret != ESP_OK)
+            return ret;
+
+        imu->state.power_mode = NORMAL_MODE;
+
+        ret = wait_for_wake(slave_handle, imu);
+        if (ret != ESP_OK)
+            return ret;
+
+        if (power_mode == NORMAL_MODE)
+            return ESP_OK;
+    }
+
+    // Other power mode changes are written in CONFIG mode, the running mode is restored afterwards
+    ret = enter_config_mode(slave_handle, imu, &previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = set_page(slave_handle, imu, 0);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = write_register(slave_handle, imu, PWR_MODE, power_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    imu->state.power_mode = power_mode;
+    ESP_LOGD("BNO_CONFIG", "Power mode set to '%d'", power_mode);
+
+    if (power_mode != SUSPEND_MODE)
+        return set_operation_mode(slave_handle, imu, previous_mode);
+
+    // Suspend is entered with the running mode, but the register map is frozen so the write cannot be verified until wake-up
+    ret = write_register(slave_handle, imu, OPR_MODE, previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    imu->state.operation_mode = previous_mode;
+    imu->state.valid = (imu->state.valid & ~BNO055_STATE_OPR_MODE) | BNO055_STATE_RESUME_MODE;
     return ESP_OK;
-}
\ No newline at end of file
+}
+
+esp_err_t bno055_power_mode_set(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_power_mode_t power_mode)
+{
+    bno055_lock(imu);
+    esp_err_t ret = set_power_mode(slave_handle, imu, power_mode);
+    bno055_unlock(imu);
+    return ret;
+}
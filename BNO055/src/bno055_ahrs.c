@@ -0,0 +1,352 @@
+#include <string.h>
+#include "bno055_ahrs.h"
+
+#define DEG_TO_RAD_F 0.0174532925f
+
+static inline float inverse_sqrtf(float value)
+{
+    // Bit-level first guess and two Newton steps, about 5e-6 relative error with no division or sqrtf;
+    // zero stays finite, so a zero vector normalises to zero rather than NaN
+    union
+    {
+        float f;
+        int32_t i;
+    } bits = {.f = value};
+    bits.i = 0x5f3759df - (bits.i >> 1);
+    float y = bits.f;
+    y = y * (1.5f - 0.5f * value * y * y);
+    y = y * (1.5f - 0.5f * value * y * y);
+    return y;
+}
+
+// One Madgwick MARG step, straight-line code so the batch loop runs the same instructions in every lane.
+// A zero magnetometer vector reduces it to the accelerometer-only gradient; a zero accelerometer vector integrates the gyroscope only
+static inline __attribute__((always_inline)) void madgwick_step(float *q0_io, float *q1_io, float *q2_io, float *q3_io,
+                                                                float gx, float gy, float gz, float ax, float ay, float az,
+                                                                float mx, float my, float mz, float beta, float dt)
+{
+    float q0 = *q0_io, q1 = *q1_io, q2 = *q2_io, q3 = *q3_io;
+
+    // Rate of change of the quaternion from the gyroscope
+    float q_dot0 = 0.5f * (-q1 * gx - q2 * gy - q3 * gz);
+    float q_dot1 = 0.5f * (q0 * gx + q2 * gz - q3 * gy);
+    float q_dot2 = 0.5f * (q0 * gy - q1 * gz + q3 * gx);
+    float q_dot3 = 0.5f * (q0 * gz + q1 * gy - q2 * gx);
+
+    float acc_norm = ax * ax + ay * ay + az * az;
+    float gain = (acc_norm > 0.0f) ? beta : 0.0f;
+    float recip_norm = inverse_sqrtf(acc_norm);
+    ax *= recip_norm;
+    ay *= recip_norm;
+    az *= recip_norm;
+    recip_norm = inverse_sqrtf(mx * mx + my * my + mz * mz);
+    mx *= recip_norm;
+    my *= recip_norm;
+    mz *= recip_norm;
+
+    float _2q0mx = 2.0f * q0 * mx, _2q0my = 2.0f * q0 * my, _2q0mz = 2.0f * q0 * mz, _2q1mx = 2.0f * q1 * mx;
+    float _2q0 = 2.0f * q0, _2q1 = 2.0f * q1, _2q2 = 2.0f * q2, _2q3 = 2.0f * q3;
+    float _2q0q2 = 2.0f * q0 * q2, _2q2q3 = 2.0f * q2 * q3;
+    float q0q0 = q0 * q0, q0q1 = q0 * q1, q0q2 = q0 * q2, q0q3 = q0 * q3;
+    float q1q1 = q1 * q1, q1q2 = q1 * q2, q1q3 = q1 * q3;
+    float q2q2 = q2 * q2, q2q3 = q2 * q3, q3q3 = q3 * q3;
+
+    // Earth's magnetic field rotated into the world frame, then flattened onto north and up
+    float hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 + _2q1 * my * q2 + _2q1 * mz * q3 - mx * q2q2 - mx * q3q3;
+    float hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 - my * q1q1 + my * q2q2 + _2q2 * mz * q3 - my * q3q3;
+    float h_norm = hx * hx + hy * hy;
+    float _2bx = h_norm * inverse_sqrtf(h_norm);
+    float _2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 - mz * q1q1 + _2q2 * my * q3 - mz * q2q2 + mz * q3q3;
+    float _4bx = 2.0f * _2bx, _4bz = 2.0f * _2bz;
+
+    // Objective function residuals, shared by the four gradient terms
+    float f_ax = 2.0f * q1q3 - _2q0q2 - ax;
+    float f_ay = 2.0f * q0q1 + _2q2q3 - ay;
+    float f_az = 1.0f - 2.0f * q1q1 - 2.0f * q2q2 - az;
+    float f_mx = _2bx * (0.5f - q2q2 - q3q3) + _2bz * (q1q3 - q0q2) - mx;
+    float f_my = _2bx * (q1q2 - q0q3) + _2bz * (q0q1 + q2q3) - my;
+    float f_mz = _2bx * (q0q2 + q1q3) + _2bz * (0.5f - q1q1 - q2q2) - mz;
+
+    // Gradient descent corrective step
+    float s0 = -_2q2 * f_ax + _2q1 * f_ay - _2bz * q2 * f_mx + (-_2bx * q3 + _2bz * q1) * f_my + _2bx * q2 * f_mz;
+    float s1 = _2q3 * f_ax + _2q0 * f_ay - 4.0f * q1 * f_az + _2bz * q3 * f_mx + (_2bx * q2 + _2bz * q0) * f_my + (_2bx * q3 - _4bz * q1) * f_mz;
+    float s2 = -_2q0 * f_ax + _2q3 * f_ay - 4.0f * q2 * f_az + (-_4bx * q2 - _2bz * q0) * f_mx + (_2bx * q1 + _2bz * q3) * f_my + (_2bx * q0 - _4bz * q2) * f_mz;
+    float s3 = _2q1 * f_ax + _2q2 * f_ay + (-_4bx * q3 + _2bz * q1) * f_mx + (-_2bx * q0 + _2bz * q2) * f_my + _2bx * q1 * f_mz;
+    recip_norm = gain * inverse_sqrtf(s0 * s0 + s1 * s1 + s2 * s2 + s3 * s3);
+
+    q0 += (q_dot0 - s0 * recip_norm) * dt;
+    q1 += (q_dot1 - s1 * recip_norm) * dt;
+    q2 += (q_dot2 - s2 * recip_norm) * dt;
+    q3 += (q_dot3 - s3 * recip_norm) * dt;
+
+    recip_norm = inverse_sqrtf(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    *q0_io = q0 * recip_norm;
+    *q1_io = q1 * recip_norm;
+    *q2_io = q2 * recip_norm;
+    *q3_io = q3 * recip_norm;
+}
+
+static void mahony_step(bno055_ahrs_t *ahrs, float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz, float dt)
+{
+    float q0 = ahrs->quaternion.w, q1 = ahrs->quaternion.x, q2 = ahrs->quaternion.y, q3 = ahrs->quaternion.z;
+    float acc_norm = ax * ax + ay * ay + az * az;
+
+    if (acc_norm > 0.0f)
+    {
+        float recip_norm = inverse_sqrtf(acc_norm);
+        ax *= recip_norm;
+        ay *= recip_norm;
+        az *= recip_norm;
+        recip_norm = inverse_sqrtf(mx * mx + my * my + mz * mz);
+        mx *= recip_norm;
+        my *= recip_norm;
+        mz *= recip_norm;
+
+        float q0q0 = q0 * q0, q0q1 = q0 * q1, q0q2 = q0 * q2, q0q3 = q0 * q3;
+        float q1q1 = q1 * q1, q1q2 = q1 * q2, q1q3 = q1 * q3;
+        float q2q2 = q2 * q2, q2q3 = q2 * q3, q3q3 = q3 * q3;
+
+        // Reference direction of the magnetic field; all zero without a magnetometer, which leaves the accelerometer error only
+        float hx = 2.0f * (mx * (0.5f - q2q2 - q3q3) + my * (q1q2 - q0q3) + mz * (q1q3 + q0q2));
+        float hy = 2.0f * (mx * (q1q2 + q0q3) + my * (0.5f - q1q1 - q3q3) + mz * (q2q3 - q0q1));
+        float h_norm = hx * hx + hy * hy;
+        float bx = h_norm * inverse_sqrtf(h_norm);
+        float bz = 2.0f * (mx * (q1q3 - q0q2) + my * (q2q3 + q0q1) + mz * (0.5f - q1q1 - q2q2));
+
+        // Estimated directions of gravity and of the magnetic field, halved
+        float half_vx = q1q3 - q0q2, half_vy = q0q1 + q2q3, half_vz = q0q0 - 0.5f + q3q3;
+        float half_wx = bx * (0.5f - q2q2 - q3q3) + bz * (q1q3 - q0q2);
+        float half_wy = bx * (q1q2 - q0q3) + bz * (q0q1 + q2q3);
+        float half_wz = bx * (q0q2 + q1q3) + bz * (0.5f - q1q1 - q2q2);
+
+        // Error is the cross product between the measured and estimated directions
+        float half_ex = (ay * half_vz - az * half_vy) + (my * half_wz - mz * half_wy);
+        float half_ey = (az * half_vx - ax * half_vz) + (mz * half_wx - mx * half_wz);
+        float half_ez = (ax * half_vy - ay * half_vx) + (mx * half_wy - my * half_wx);
+
+        if (ahrs->config.ki > 0.0f)
+        {
+            ahrs->integral_error.x += 2.0f * ahrs->config.ki * half_ex * dt;
+            ahrs->integral_error.y += 2.0f * ahrs->config.ki * half_ey * dt;
+            ahrs->integral_error.z += 2.0f * ahrs->config.ki * half_ez * dt;
+            gx += ahrs->integral_error.x;
+            gy += ahrs->integral_error.y;
+            gz += ahrs->integral_error.z;
+        }
+
+        gx += 2.0f * ahrs->config.kp * half_ex;
+        gy += 2.0f * ahrs->config.kp * half_ey;
+        gz += 2.0f * ahrs->config.kp * half_ez;
+    }
+
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    float qa = q0, qb = q1, qc = q2;
+    q0 += -qb * gx - qc * gy - q3 * gz;
+    q1 += qa * gx + qc * gz - q3 * gy;
+    q2 += qa * gy - qb * gz + q3 * gx;
+    q3 += qa * gz + qb * gy - qc * gx;
+
+    float recip_norm = inverse_sqrtf(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    ahrs->quaternion.w = q0 * recip_norm;
+    ahrs->quaternion.x = q1 * recip_norm;
+    ahrs->quaternion.y = q2 * recip_norm;
+    ahrs->quaternion.z = q3 * recip_norm;
+}
+
+static void cross(const vector_t *a, const vector_t *b, vector_t *result)
+{
+    result->x = a->y * b->z - a->z * b->y;
+    result->y = a->z * b->x - a->x * b->z;
+    result->z = a->x * b->y - a->y * b->x;
+}
+
+static bool normalize_vector(vector_t *vector)
+{
+    float norm = vector->x * vector->x + vector->y * vector->y + vector->z * vector->z;
+    if (norm <= 0.0f)
+        return false;
+
+    float recip_norm = inverse_sqrtf(norm);
+    vector->x *= recip_norm;
+    vector->y *= recip_norm;
+    vector->z *= recip_norm;
+    return true;
+}
+
+// Starts the filter at the orientation of the first sample instead of converging from identity
+static bool initialize_orientation(bno055_ahrs_t *ahrs, const vector_t *acceleration, const vector_t *magnetometer)
+{
+    vector_t up = *acceleration, north_hint = *magnetometer, west, north;
+
+    if (!normalize_vector(&up))
+        return false;
+
+    // Without a magnetometer any horizontal direction will do, the heading is then relative
+    if (!normalize_vector(&north_hint))
+        north_hint = (absolute(up.x) < 0.9f) ? (vector_t){1.0f, 0.0f, 0.0f} : (vector_t){0.0f, 1.0f, 0.0f};
+
+    cross(&up, &north_hint, &west);
+    if (!normalize_vector(&west))
+        return false;
+
+    cross(&west, &up, &north);
+
+    // Rows of the sensor to world rotation are the world axes seen from the sensor
+    float m[3][3] = {{north.x, north.y, north.z}, {west.x, west.y, west.z}, {up.x, up.y, up.z}};
+    float trace = m[0][0] + m[1][1] + m[2][2], s;
+    quaternion_t *q = &ahrs->quaternion;
+
+    if (trace > 0.0f)
+    {
+        s = 0.5f * inverse_sqrtf(trace + 1.0f);
+        q->w = 0.25f / s;
+        q->x = (m[2][1] - m[1][2]) * s;
+        q->y = (m[0][2] - m[2][0]) * s;
+        q->z = (m[1][0] - m[0][1]) * s;
+    }
+    else if (m[0][0] > m[1][1] && m[0][0] > m[2][2])
+    {
+        s = 2.0f * sqrtf(1.0f + m[0][0] - m[1][1] - m[2][2]);
+        q->w = (m[2][1] - m[1][2]) / s;
+        q->x = 0.25f * s;
+        q->y = (m[0][1] + m[1][0]) / s;
+        q->z = (m[0][2] + m[2][0]) / s;
+    }
+    else if (m[1][1] > m[2][2])
+    {
+        s = 2.0f * sqrtf(1.0f + m[1][1] - m[0][0] - m[2][2]);
+        q->w = (m[0][2] - m[2][0]) / s;
+        q->x = (m[0][1] + m[1][0]) / s;
+        q->y = 0.25f * s;
+        q->z = (m[1][2] + m[2][1]) / s;
+    }
+    else
+    {
+        s = 2.0f * sqrtf(1.0f + m[2][2] - m[0][0] - m[1][1]);
+        q->w = (m[1][0] - m[0][1]) / s;
+        q->x = (m[0][2] + m[2][0]) / s;
+        q->y = (m[1][2] + m[2][1]) / s;
+        q->z = 0.25f * s;
+    }
+
+    return true;
+}
+
+esp_err_t bno055_ahrs_init_default_config(bno055_ahrs_config_t *ahrs_config)
+{
+    if (ahrs_config == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // Gains of the reference implementations
+    ahrs_config->filter = MADGWICK_FILTER;
+    ahrs_config->beta = 0.1f;
+    ahrs_config->kp = 0.5f;
+    ahrs_config->ki = 0.0f;
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_ahrs_init(bno055_ahrs_t *ahrs, const bno055_ahrs_config_t *ahrs_config)
+{
+    if (ahrs == NULL || ahrs_config == NULL || ahrs_config->filter > MAHONY_FILTER)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(ahrs, 0, sizeof(bno055_ahrs_t));
+    ahrs->config = *ahrs_config;
+    ahrs->quaternion.w = 1.0f;
+
+    return ESP_OK;
+}
+
+void bno055_ahrs_update(bno055_ahrs_t *ahrs, const vector_t *gyroscope, const vector_t *acceleration, const vector_t *magnetometer, float dt)
+{
+    if (ahrs->updates == 0 && initialize_orientation(ahrs, acceleration, magnetometer))
+    {
+        ahrs->updates++;
+        return;
+    }
+
+    if (dt < 0.0f)
+        dt = 0.0f;
+    else if (dt > BNO055_AHRS_MAX_DT_S)
+        dt = BNO055_AHRS_MAX_DT_S;
+
+    switch (ahrs->config.filter)
+    {
+    case MAHONY_FILTER:
+        mahony_step(ahrs, gyroscope->x, gyroscope->y, gyroscope->z, acceleration->x, acceleration->y, acceleration->z, magnetometer->x, magnetometer->y, magnetometer->z, dt);
+        break;
+
+    default:
+        madgwick_step(&ahrs->quaternion.w, &ahrs->quaternion.x, &ahrs->quaternion.y, &ahrs->quaternion.z, gyroscope->x, gyroscope->y, gyroscope->z, acceleration->x, acceleration->y, acceleration->z, magnetometer->x, magnetometer->y, magnetometer->z, ahrs->config.beta, dt);
+        break;
+    }
+
+    ahrs->updates++;
+}
+
+esp_err_t bno055_ahrs_update_imu(bno055_ahrs_t *ahrs, imu_t *imu, int64_t timestamp_us)
+{
+    if (ahrs == NULL || imu == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // The filter works in rad/s, the other two vectors are normalised so their units do not matter
+    float gyro_scale = (imu->bno055_config.sensor_scale.gyro == 900.0f) ? 1.0f : DEG_TO_RAD_F;
+    vector_t gyroscope = {imu->gyroscope.x * gyro_scale, imu->gyroscope.y * gyro_scale, imu->gyroscope.z * gyro_scale};
+    float dt = (ahrs->last_timestamp_us != 0) ? (timestamp_us - ahrs->last_timestamp_us) * 1e-6f : 0.0f;
+
+    bno055_ahrs_update(ahrs, &gyroscope, &imu->raw_acceleration, &imu->magnetometer, dt);
+    ahrs->last_timestamp_us = timestamp_us;
+
+    // Same outputs as the chip's fusion modes, in the selected units
+    imu->quaternion = ahrs->quaternion;
+    bno055_derive_orientation(imu);
+    imu->linear_acceleration.x = imu->raw_acceleration.x - imu->gravity.x;
+    imu->linear_acceleration.y = imu->raw_acceleration.y - imu->gravity.y;
+    imu->linear_acceleration.z = imu->raw_acceleration.z - imu->gravity.z;
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_ahrs_update_raw(bno055_ahrs_t *ahrs, imu_t *imu, const bno055_raw_sample_t *sample)
+{
+    if (ahrs == NULL || imu == NULL || sample == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    bno055_raw_sample_to_vectors(imu, sample, &imu->raw_acceleration, &imu->magnetometer, &imu->gyroscope);
+    return bno055_ahrs_update_imu(ahrs, imu, sample->timestamp_us);
+}
+
+esp_err_t bno055_ahrs_read(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_ahrs_t *ahrs)
+{
+    if (imu == NULL || ahrs == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // The chip's own fusion would fight the host filter over the sensor settings
+    if ((imu->state.valid & BNO055_STATE_OPR_MODE) && imu->state.operation_mode != AMG_MODE)
+        return ESP_ERR_INVALID_STATE;
+
+    // Accelerometer, magnetometer and gyroscope are adjacent, one 18-byte burst
+    esp_err_t ret = bno055_get_sensor_readings(slave_handle, imu, ACCELEROMETER_MASK | MAGNETOMETER_MASK | GYROSCOPE_MASK);
+    if (ret != ESP_OK)
+        return ret;
+
+    return bno055_ahrs_update_imu(ahrs, imu, esp_timer_get_time());
+}
+
+void bno055_ahrs_batch_update(bno055_ahrs_batch_t *batch, size_t count, float beta, float dt)
+{
+    float *restrict qw = batch->qw, *restrict qx = batch->qx, *restrict qy = batch->qy, *restrict qz = batch->qz;
+    const float *restrict gx = batch->gx, *restrict gy = batch->gy, *restrict gz = batch->gz;
+    const float *restrict ax = batch->ax, *restrict ay = batch->ay, *restrict az = batch->az;
+    const float *restrict mx = batch->mx, *restrict my = batch->my, *restrict mz = batch->mz;
+
+    if (count > BNO055_AHRS_BATCH_SIZE)
+        count = BNO055_AHRS_BATCH_SIZE;
+
+    // No branches or lane-dependent control flow, so a compiler for a SIMD target can run the lanes side by side
+    for (size_t i = 0; i < count; i++)
+        madgwick_step(&qw[i], &qx[i], &qy[i], &qz[i], gx[i], gy[i], gz[i], ax[i], ay[i], az[i], mx[i], my[i], mz[i], beta, dt);
+}
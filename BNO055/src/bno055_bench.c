@@ -0,0 +1,277 @@
+#include <string.h>
+#include "bno055_bench.h"
+
+static float angle_error(float host, float chip, float full_turn)
+{
+    float error = absolute(host - chip);
+
+    // Heading wraps at a full turn, pitch at half of one either side
+    if (error > full_turn / 2.0f)
+        error = full_turn - error;
+
+    return error;
+}
+
+esp_err_t bno055_bench_orientation(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint32_t iterations, bno055_bench_orientation_t *result)
+{
+    esp_err_t ret;
+    bno055_read_plan_t chip_plan, quaternion_plan;
+    uint64_t derive_cycles = 0, quaternion_read_us = 0, chip_read_us = 0;
+
+    if (imu == NULL || result == NULL || iterations == 0)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(result, 0, sizeof(bno055_bench_orientation_t));
+    bno055_plan_readings(EULER_ANGLE_MASK | QUATERNION_MASK | GRAVITY_MASK, BNO055_TRANSACTION_OVERHEAD_BYTES, &chip_plan);
+    bno055_plan_readings(QUATERNION_MASK, BNO055_TRANSACTION_OVERHEAD_BYTES, &quaternion_plan);
+    result->chip_bus_bytes = chip_plan.bus_bytes;
+    result->quaternion_bus_bytes = quaternion_plan.bus_bytes;
+
+    float full_turn = (imu->bno055_config.sensor_scale.euler == 900.0f) ? 6.28318531f : 360.0f;
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        // Chip outputs from one burst, so all three belong to the same fusion step
+        int64_t start = esp_timer_get_time();
+        ret = bno055_get_planned_readings(slave_handle, imu, &chip_plan);
+        chip_read_us += esp_timer_get_time() - start;
+        if (ret != ESP_OK)
+            return ret;
+
+        vector_t chip_euler = imu->euler_angles, chip_gravity = imu->gravity;
+
+        esp_cpu_cycle_count_t cycles = esp_cpu_get_cycle_count();
+        bno055_derive_orientation(imu);
+        derive_cycles += (uint32_t)(esp_cpu_get_cycle_count() - cycles);
+
+        float errors[] = {
+            angle_error(imu->euler_angles.x, chip_euler.x, full_turn),
+            absolute(imu->euler_angles.y - chip_euler.y),
+            angle_error(imu->euler_angles.z, chip_euler.z, full_turn),
+        };
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+            if (errors[axis] > result->max_euler_error)
+                result->max_euler_error = errors[axis];
+        }
+
+        float gravity_errors[] = {
+            absolute(imu->gravity.x - chip_gravity.x),
+            absolute(imu->gravity.y - chip_gravity.y),
+            absolute(imu->gravity.z - chip_gravity.z),
+        };
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+            if (gravity_errors[axis] > result->max_gravity_error)
+                result->max_gravity_error = gravity_errors[axis];
+        }
+
+        start = esp_timer_get_time();
+        ret = bno055_get_planned_readings(slave_handle, imu, &quaternion_plan);
+        quaternion_read_us += esp_timer_get_time() - start;
+        if (ret != ESP_OK)
+            return ret;
+
+        // One fusion step at 100 Hz, so successive iterations see fresh outputs
+        vTaskDelay(pdMS_TO_TICKS(10) > 0 ? pdMS_TO_TICKS(10) : 1);
+    }
+
+    result->iterations = iterations;
+    result->derive_cycles = (uint32_t)(derive_cycles / iterations);
+    result->quaternion_read_us = (uint32_t)(quaternion_read_us / iterations);
+    result->chip_read_us = (uint32_t)(chip_read_us / iterations);
+
+    ESP_LOGI("BNO_BENCH", "Orientation: derive %d cycles, quaternion read %d us (%d bytes), chip read %d us (%d bytes), max error Euler %.4f gravity %.4f", (int)result->derive_cycles, (int)result->quaternion_read_us, result->quaternion_bus_bytes, (int)result->chip_read_us, result->chip_bus_bytes, result->max_euler_error, result->max_gravity_error);
+    return ESP_OK;
+}
+
+esp_err_t bno055_bench_transport(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint32_t iterations, bno055_bench_transport_t *result)
+{
+    uint8_t register_content[BNO055_OUTPUT_BURST_LENGTH];
+    uint64_t single_read_us = 0, burst_read_us = 0;
+
+    if (imu == NULL || result == NULL || iterations == 0)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(result, 0, sizeof(bno055_bench_transport_t));
+    result->type = imu->transport.type;
+    result->burst_bytes = BNO055_OUTPUT_BURST_LENGTH;
+
+    // The output registers are on page 0, set once so the loop times single transactions
+    esp_err_t ret = bno055_read_registers(slave_handle, imu, 0, CHIP_ID, register_content, 1);
+    if (ret != ESP_OK)
+        return ret;
+
+    bno055_transport_reset_stats(&imu->transport);
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        int64_t start = esp_timer_get_time();
+        ret = bno055_transport_read(slave_handle, &imu->transport, CHIP_ID, register_content, 1, 0);
+        uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start);
+        if (ret != ESP_OK)
+            return ret;
+
+        single_read_us += elapsed_us;
+        if (elapsed_us > result->single_read_max_us)
+            result->single_read_max_us = elapsed_us;
+
+        start = esp_timer_get_time();
+        ret = bno055_transport_read(slave_handle, &imu->transport, ACC_DATA_X_LSB, register_content, BNO055_OUTPUT_BURST_LENGTH, 0);
+        elapsed_us = (uint32_t)(esp_timer_get_time() - start);
+        if (ret != ESP_OK)
+            return ret;
+
+        burst_read_us += elapsed_us;
+        if (elapsed_us > result->burst_read_max_us)
+            result->burst_read_max_us = elapsed_us;
+    }
+
+    result->iterations = iterations;
+    result->single_read_us = (uint32_t)(single_read_us / iterations);
+    result->burst_read_us = (uint32_t)(burst_read_us / iterations);
+    result->errors = imu->transport.stats.errors;
+    result->retries = imu->transport.stats.retries;
+
+    ESP_LOGI("BNO_BENCH", "%s: single read %d us (max %d), %d byte burst %d us (max %d), %d retries", result->type == UART_TRANSPORT ? "UART" : "I2C", (int)result->single_read_us, (int)result->single_read_max_us, result->burst_bytes, (int)result->burst_read_us, (int)result->burst_read_max_us, (int)result->retries);
+    return ESP_OK;
+}
+
+esp_err_t bno055_bench_ahrs_record(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_ahrs_record_t *records, uint32_t count)
+{
+    bno055_read_plan_t plan;
+
+    if (imu == NULL || records == NULL || count == 0)
+        return ESP_ERR_INVALID_ARG;
+
+    // The chip's fusion output is the reference, so it has to be running
+    if (!(imu->state.valid & BNO055_STATE_OPR_MODE) || imu->state.operation_mode != NDOF_MODE)
+        return ESP_ERR_INVALID_STATE;
+
+    // Sensor data and quaternion sit in one span, so a record is one consistent burst
+    bno055_plan_readings(ACCELEROMETER_MASK | MAGNETOMETER_MASK | GYROSCOPE_MASK | QUATERNION_MASK, BNO055_TRANSACTION_OVERHEAD_BYTES, &plan);
+
+    float gyro_scale = (imu->bno055_config.sensor_scale.gyro == 900.0f) ? 1.0f : 0.0174532925f;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        esp_err_t ret = bno055_get_planned_readings(slave_handle, imu, &plan);
+        if (ret != ESP_OK)
+            return ret;
+
+        records[i].timestamp_us = esp_timer_get_time();
+        records[i].gyroscope.x = imu->gyroscope.x * gyro_scale;
+        records[i].gyroscope.y = imu->gyroscope.y * gyro_scale;
+        records[i].gyroscope.z = imu->gyroscope.z * gyro_scale;
+        records[i].acceleration = imu->raw_acceleration;
+        records[i].magnetometer = imu->magnetometer;
+        records[i].quaternion = imu->quaternion;
+
+        // One fusion step at 100 Hz
+        vTaskDelay(pdMS_TO_TICKS(10) > 0 ? pdMS_TO_TICKS(10) : 1);
+    }
+
+    ESP_LOGI("BNO_BENCH", "Recorded %d NDOF steps over %d ms", (int)count, (int)((records[count - 1].timestamp_us - records[0].timestamp_us) / 1000));
+    return ESP_OK;
+}
+
+esp_err_t bno055_bench_ahrs_replay(const bno055_ahrs_config_t *ahrs_config, const bno055_ahrs_record_t *records, uint32_t count, uint32_t settle_count, bno055_bench_ahrs_t *result)
+{
+    bno055_ahrs_t ahrs;
+    bno055_ahrs_batch_t batch;
+    uint64_t update_cycles = 0, batch_cycles = 0;
+    double error_sum = 0.0;
+
+    if (ahrs_config == NULL || records == NULL || result == NULL || count < 2)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = bno055_ahrs_init(&ahrs, ahrs_config);
+    if (ret != ESP_OK)
+        return ret;
+
+    memset(result, 0, sizeof(bno055_bench_ahrs_t));
+    result->filter = ahrs_config->filter;
+
+    // The first record only seeds the orientation
+    bno055_ahrs_update(&ahrs, &records[0].gyroscope, &records[0].acceleration, &records[0].magnetometer, 0.0f);
+
+    for (uint32_t i = 1; i < count; i++)
+    {
+        const bno055_ahrs_record_t *record = &records[i];
+        float dt = (record->timestamp_us - records[i - 1].timestamp_us) * 1e-6f;
+
+        esp_cpu_cycle_count_t cycles = esp_cpu_get_cycle_count();
+        bno055_ahrs_update(&ahrs, &record->gyroscope, &record->acceleration, &record->magnetometer, dt);
+        uint32_t elapsed = (uint32_t)(esp_cpu_get_cycle_count() - cycles);
+
+        update_cycles += elapsed;
+        if (elapsed > result->update_max_cycles)
+            result->update_max_cycles = elapsed;
+
+        // Every lane gets the same step, only the cost matters here
+        for (size_t lane = 0; lane < BNO055_AHRS_BATCH_SIZE; lane++)
+        {
+            batch.qw[lane] = ahrs.quaternion.w;
+            batch.qx[lane] = ahrs.quaternion.x;
+            batch.qy[lane] = ahrs.quaternion.y;
+            batch.qz[lane] = ahrs.quaternion.z;
+            batch.gx[lane] = record->gyroscope.x;
+            batch.gy[lane] = record->gyroscope.y;
+            batch.gz[lane] = record->gyroscope.z;
+            batch.ax[lane] = record->acceleration.x;
+            batch.ay[lane] = record->acceleration.y;
+            batch.az[lane] = record->acceleration.z;
+            batch.mx[lane] = record->magnetometer.x;
+            batch.my[lane] = record->magnetometer.y;
+            batch.mz[lane] = record->magnetometer.z;
+        }
+
+        cycles = esp_cpu_get_cycle_count();
+        bno055_ahrs_batch_update(&batch, BNO055_AHRS_BATCH_SIZE, ahrs_config->beta, dt);
+        batch_cycles += (uint32_t)(esp_cpu_get_cycle_count() - cycles);
+
+        // Give the filter time to converge before holding it to the chip
+        if (i < settle_count)
+            continue;
+
+        // Rotation angle of conj(host) * chip; atan2 keeps small angles exact where acos of a dot product near 1 does not
+        const quaternion_t *host = &ahrs.quaternion, *chip = &record->quaternion;
+        float rw = host->w * chip->w + host->x * chip->x + host->y * chip->y + host->z * chip->z;
+        float rx = host->w * chip->x - host->x * chip->w - host->y * chip->z + host->z * chip->y;
+        float ry = host->w * chip->y + host->x * chip->z - host->y * chip->w - host->z * chip->x;
+        float rz = host->w * chip->z - host->x * chip->y + host->y * chip->x - host->z * chip->w;
+        float error = 2.0f * atan2f(sqrtf(rx * rx + ry * ry + rz * rz), absolute(rw)) * 57.2957795f;
+
+        error_sum += error;
+        if (error > result->max_error_deg)
+            result->max_error_deg = error;
+
+        vector_t host_gravity, chip_gravity, host_euler, chip_euler;
+        quaternion_to_gravity(host, 1.0f, &host_gravity);
+        quaternion_to_gravity(chip, 1.0f, &chip_gravity);
+        float cosine = host_gravity.x * chip_gravity.x + host_gravity.y * chip_gravity.y + host_gravity.z * chip_gravity.z;
+        float sine_x = host_gravity.y * chip_gravity.z - host_gravity.z * chip_gravity.y;
+        float sine_y = host_gravity.z * chip_gravity.x - host_gravity.x * chip_gravity.z;
+        float sine_z = host_gravity.x * chip_gravity.y - host_gravity.y * chip_gravity.x;
+        float tilt_error = atan2f(sqrtf(sine_x * sine_x + sine_y * sine_y + sine_z * sine_z), cosine) * 57.2957795f;
+        if (tilt_error > result->max_tilt_error_deg)
+            result->max_tilt_error_deg = tilt_error;
+
+        quaternion_to_euler(host, false, false, &host_euler);
+        quaternion_to_euler(chip, false, false, &chip_euler);
+        float heading_error = angle_error(host_euler.x, chip_euler.x, 360.0f);
+        if (heading_error > result->max_heading_error_deg)
+            result->max_heading_error_deg = heading_error;
+
+        result->compared++;
+    }
+
+    result->updates = count - 1;
+    result->update_cycles = (uint32_t)(update_cycles / result->updates);
+    result->batch_lane_cycles = (uint32_t)(batch_cycles / result->updates / BNO055_AHRS_BATCH_SIZE);
+    if (result->compared > 0)
+        result->mean_error_deg = (float)(error_sum / result->compared);
+
+    ESP_LOGI("BNO_BENCH", "%s: %d cycles per update (max %d), %d per batch lane, versus NDOF mean %.2f max %.2f deg, tilt %.2f deg, heading %.2f deg", result->filter == MAHONY_FILTER ? "Mahony" : "Madgwick", (int)result->update_cycles, (int)result->update_max_cycles, (int)result->batch_lane_cycles, result->mean_error_deg, result->max_error_deg, result->max_tilt_error_deg, result->max_heading_error_deg);
+    return ESP_OK;
+}
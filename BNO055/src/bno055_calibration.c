@@ -0,0 +1,99 @@
+#include "bno055_calibration.h"
+
+esp_err_t bno055_save_calibration(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const char *key)
+{
+    nvs_handle_t nvs;
+    bno055_calibration_blob_t blob = {
+        .version = BNO055_CALIBRATION_BLOB_VERSION,
+        .length = BNO055_CALIBRATION_PROFILE_LENGTH,
+    };
+
+    if (imu == NULL || key == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = bno055_get_sensor_readings(slave_handle, imu, CALIBRATION_STATUS_MASK);
+    if (ret != ESP_OK)
+        return ret;
+
+    // A partial profile is still better than none, but say so
+    blob.calibration_status = imu->calibration_status;
+    if (blob.calibration_status != 0xff)
+        ESP_LOGW("BNO_CONFIG", "Saving a partially calibrated profile - Acc: %d, Gyro: %d, Mag: %d, Sys: %d", (blob.calibration_status & 0x0c) / 4, (blob.calibration_status & 0x30) / 16, (blob.calibration_status & 0x03), (blob.calibration_status & 0xc0) / 64);
+
+    ret = bno055_get_calibration_profile(slave_handle, imu, &blob.profile);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = nvs_open(BNO055_CALIBRATION_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE("BNO_CONFIG", "Failed to open NVS namespace '%s'. Error: %s", BNO055_CALIBRATION_NVS_NAMESPACE, esp_err_to_name(ret));
+        return ret;
+    }
+
+    ret = nvs_set_blob(nvs, key, &blob, sizeof(blob));
+    if (ret == ESP_OK)
+        ret = nvs_commit(nvs);
+    nvs_close(nvs);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE("BNO_CONFIG", "Failed to store calibration profile '%s'. Error: %s", key, esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGI("BNO_CONFIG", "Saved calibration profile '%s'", key);
+    return ESP_OK;
+}
+
+esp_err_t bno055_restore_calibration(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const char *key)
+{
+    nvs_handle_t nvs;
+    bno055_calibration_blob_t blob;
+    size_t length = sizeof(blob);
+
+    if (imu == NULL || key == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = nvs_open(BNO055_CALIBRATION_NVS_NAMESPACE, NVS_READONLY, &nvs);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = nvs_get_blob(nvs, key, &blob, &length);
+    nvs_close(nvs);
+    if (ret != ESP_OK)
+        return ret;
+
+    if (length != sizeof(blob) || blob.version != BNO055_CALIBRATION_BLOB_VERSION || blob.length != BNO055_CALIBRATION_PROFILE_LENGTH)
+    {
+        ESP_LOGW("BNO_CONFIG", "Calibration profile '%s' has version %d, expected %d", key, length >= sizeof(blob.version) ? blob.version : 0, BNO055_CALIBRATION_BLOB_VERSION);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    // Written in one burst, the device returns to the mode it was in
+    ret = bno055_set_calibration_profile(slave_handle, imu, &blob.profile);
+    if (ret != ESP_OK)
+        return ret;
+
+    ESP_LOGI("BNO_CONFIG", "Restored calibration profile '%s'", key);
+    return ESP_OK;
+}
+
+esp_err_t bno055_erase_calibration(const char *key)
+{
+    nvs_handle_t nvs;
+
+    if (key == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = nvs_open(BNO055_CALIBRATION_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = nvs_erase_key(nvs, key);
+    if (ret == ESP_OK)
+        ret = nvs_commit(nvs);
+    nvs_close(nvs);
+
+    return ret;
+}
@@ -0,0 +1,324 @@
+#include <string.h>
+#include "bno055_group.h"
+
+static void copy_snapshot(const imu_t *imu, bno055_snapshot_t *snapshot)
+{
+    snapshot->raw_acceleration = imu->raw_acceleration;
+    snapshot->gyroscope = imu->gyroscope;
+    snapshot->magnetometer = imu->magnetometer;
+    snapshot->euler_angles = imu->euler_angles;
+    snapshot->quaternion = imu->quaternion;
+    snapshot->linear_acceleration = imu->linear_acceleration;
+    snapshot->gravity = imu->gravity;
+    snapshot->temperature = imu->temperature;
+    snapshot->calibration_status = imu->calibration_status;
+}
+
+// Runs in the bus task that finished last, the other bus is idle until the next trigger
+static void publish_frame(bno055_group_t *group)
+{
+    bno055_group_frame_t *assembly = &group->assembly;
+    int64_t earliest = INT64_MAX, latest = INT64_MIN;
+
+    for (size_t i = 0; i < group->config.device_count; i++)
+    {
+        if ((assembly->valid_mask & (1 << i)) == 0)
+            continue;
+
+        if (assembly->devices[i].timestamp_us < earliest)
+            earliest = assembly->devices[i].timestamp_us;
+        if (assembly->devices[i].timestamp_us > latest)
+            latest = assembly->devices[i].timestamp_us;
+    }
+
+    assembly->skew_us = (latest >= earliest) ? (uint32_t)(latest - earliest) : 0;
+    assembly->duration_us = (uint32_t)(esp_timer_get_time() - assembly->trigger_us);
+
+    group->last_skew_us = assembly->skew_us;
+    group->total_skew_us += assembly->skew_us;
+    if (assembly->skew_us > group->max_skew_us)
+        group->max_skew_us = assembly->skew_us;
+    if (assembly->duration_us > group->max_duration_us)
+        group->max_duration_us = assembly->duration_us;
+
+    // Same seqlock as the sampler, the critical section only keeps the writer from being preempted mid-copy
+    portENTER_CRITICAL(&group->write_lock);
+    uint32_t sequence = __atomic_load_n(&group->seqlock, __ATOMIC_RELAXED);
+    __atomic_store_n(&group->seqlock, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&group->frame, assembly, sizeof(bno055_group_frame_t));
+    __atomic_store_n(&group->seqlock, sequence + 2, __ATOMIC_RELEASE);
+    portEXIT_CRITICAL(&group->write_lock);
+}
+
+static void group_timer_callback(void *arg)
+{
+    bno055_group_t *group = (bno055_group_t *)arg;
+
+    // A frame is only started once the previous one is out, so every frame holds one trigger's reads
+    if (__atomic_load_n(&group->busy, __ATOMIC_ACQUIRE))
+    {
+        group->overruns++;
+        return;
+    }
+
+    __atomic_store_n(&group->busy, true, __ATOMIC_RELAXED);
+    group->assembly.valid_mask = 0;
+    group->assembly.sequence++;
+    group->assembly.trigger_us = esp_timer_get_time();
+    __atomic_store_n(&group->pending, group->bus_count, __ATOMIC_RELEASE);
+
+    for (size_t bus = 0; bus < group->bus_count; bus++)
+        xTaskNotifyGive(group->buses[bus].task);
+}
+
+static void group_bus_task(void *arg)
+{
+    bno055_group_bus_t *bus = (bno055_group_bus_t *)arg;
+    bno055_group_t *group = bus->group;
+
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (group->stop_requested)
+            break;
+
+        int64_t bus_start = esp_timer_get_time();
+        uint8_t valid_mask = 0;
+
+        // Devices on one controller share its bus, so they are read back to back
+        for (size_t i = 0; i < bus->device_count; i++)
+        {
+            uint8_t index = bus->devices[i];
+            const bno055_group_device_t *device = &group->config.devices[index];
+            bno055_snapshot_t *snapshot = &group->assembly.devices[index];
+
+            // The imu_t may be shared with other tasks, keep it locked until its fields are in the frame
+            bno055_lock(device->imu);
+
+            int64_t start = esp_timer_get_time();
+            esp_err_t ret = bno055_get_planned_readings(device->slave_handle, device->imu, &group->plan);
+            int64_t end = esp_timer_get_time();
+
+            if (ret == ESP_OK)
+                copy_snapshot(device->imu, snapshot);
+
+            bno055_unlock(device->imu);
+
+            if (ret != ESP_OK)
+            {
+                __atomic_fetch_add(&group->read_errors, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+
+            snapshot->timestamp_us = start + (end - start) / 2;
+            snapshot->sequence = group->assembly.sequence;
+            valid_mask |= 1 << index;
+        }
+
+        uint32_t bus_us = (uint32_t)(esp_timer_get_time() - bus_start);
+        if (bus_us > bus->max_bus_us)
+            bus->max_bus_us = bus_us;
+
+        __atomic_fetch_or(&group->assembly.valid_mask, valid_mask, __ATOMIC_RELAXED);
+
+        // The bus finishing last publishes the frame and lets the next trigger through
+        if (__atomic_sub_fetch(&group->pending, 1, __ATOMIC_ACQ_REL) == 0)
+        {
+            publish_frame(group);
+            __atomic_store_n(&group->busy, false, __ATOMIC_RELEASE);
+        }
+    }
+
+    bus->running = false;
+    vTaskDelete(NULL);
+}
+
+esp_err_t bno055_group_init_default_config(bno055_group_config_t *group_config)
+{
+    if (group_config == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(group_config, 0, sizeof(bno055_group_config_t));
+    group_config->sensor_mask = QUATERNION_MASK | LINEAR_ACCELERATION_MASK | GRAVITY_MASK;
+    group_config->period_ms = 10;
+    group_config->task_priority = 5;
+    group_config->core_ids[0] = 0;
+    group_config->core_ids[1] = 1;
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_group_start(const bno055_group_config_t *group_config, bno055_group_t *group)
+{
+    if (group_config == NULL || group == NULL || group_config->device_count == 0 || group_config->device_count > BNO055_GROUP_MAX_DEVICES || group_config->period_ms == 0)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(group, 0, sizeof(bno055_group_t));
+    group->config = *group_config;
+    spinlock_initialize(&group->write_lock);
+
+    for (size_t i = 0; i < group_config->device_count; i++)
+    {
+        const bno055_group_device_t *device = &group_config->devices[i];
+
+        if (device->imu == NULL || (device->slave_handle == NULL && device->imu->transport.type == I2C_TRANSPORT) || device->bus >= BNO055_GROUP_MAX_BUSES)
+            return ESP_ERR_INVALID_ARG;
+
+        bno055_group_bus_t *bus = &group->buses[device->bus];
+        if (bus->device_count == BNO055_GROUP_MAX_DEVICES_PER_BUS)
+        {
+            ESP_LOGE("BNO_GROUP", "More than %d devices on bus %d", BNO055_GROUP_MAX_DEVICES_PER_BUS, device->bus);
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        bus->devices[bus->device_count++] = i;
+    }
+
+    // Buses are used in order, so an unused first bus would leave a task waiting forever
+    for (size_t bus = 0; bus < BNO055_GROUP_MAX_BUSES && group->buses[bus].device_count > 0; bus++)
+        group->bus_count++;
+
+    for (size_t bus = group->bus_count; bus < BNO055_GROUP_MAX_BUSES; bus++)
+    {
+        if (group->buses[bus].device_count > 0)
+        {
+            ESP_LOGE("BNO_GROUP", "Bus %d has devices but bus %d has none", (int)bus, (int)group->bus_count);
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    // Planned once, every device and period is then the same burst reads
+    esp_err_t ret = bno055_plan_readings(group_config->sensor_mask, BNO055_TRANSACTION_OVERHEAD_BYTES, &group->plan);
+    if (ret != ESP_OK)
+        return ret;
+
+    for (size_t bus = 0; bus < group->bus_count; bus++)
+    {
+        group->buses[bus].group = group;
+        group->buses[bus].running = true;
+        if (xTaskCreatePinnedToCore(group_bus_task, "bno055_bus", BNO055_GROUP_TASK_STACK, &group->buses[bus], group_config->task_priority, &group->buses[bus].task, group_config->core_ids[bus]) != pdPASS)
+        {
+            group->buses[bus].running = false;
+            (void)bno055_group_stop(group);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = group_timer_callback,
+        .arg = group,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "bno055_group"};
+
+    ret = esp_timer_create(&timer_args, &group->timer);
+    if (ret == ESP_OK)
+        ret = esp_timer_start_periodic(group->timer, (uint64_t)group_config->period_ms * 1000);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE("BNO_GROUP", "Failed to start the group timer: %s", esp_err_to_name(ret));
+        (void)bno055_group_stop(group);
+        return ret;
+    }
+
+    ESP_LOGD("BNO_GROUP", "Reading %d devices on %d buses every %d ms (%d bus bytes per device)", group_config->device_count, group->bus_count, (int)group_config->period_ms, group->plan.bus_bytes);
+    return ESP_OK;
+}
+
+esp_err_t bno055_group_stop(bno055_group_t *group)
+{
+    bool running = false;
+
+    if (group == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    if (group->timer != NULL)
+    {
+        (void)esp_timer_stop(group->timer);
+        (void)esp_timer_delete(group->timer);
+        group->timer = NULL;
+    }
+
+    // Each task exits after its current frame
+    group->stop_requested = true;
+    for (size_t bus = 0; bus < group->bus_count; bus++)
+    {
+        if (group->buses[bus].running)
+        {
+            running = true;
+            xTaskNotifyGive(group->buses[bus].task);
+        }
+    }
+
+    if (!running)
+        return ESP_ERR_INVALID_STATE;
+
+    for (size_t i = 0; i < 100; i++)
+    {
+        running = false;
+        for (size_t bus = 0; bus < group->bus_count; bus++)
+            running |= group->buses[bus].running;
+
+        if (!running)
+            return ESP_OK;
+
+        vTaskDelay(pdMS_TO_TICKS(group->config.period_ms) > 0 ? pdMS_TO_TICKS(group->config.period_ms) : 1);
+    }
+
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t bno055_group_read(bno055_group_t *group, bno055_group_frame_t *frame, int64_t *age_us)
+{
+    uint32_t before, after;
+
+    if (group == NULL || frame == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // Lock-free: copy, then retry if a publish started or finished in between
+    while (1)
+    {
+        before = __atomic_load_n(&group->seqlock, __ATOMIC_ACQUIRE);
+        if ((before & 1) == 0)
+        {
+            memcpy(frame, &group->frame, sizeof(bno055_group_frame_t));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            after = __atomic_load_n(&group->seqlock, __ATOMIC_RELAXED);
+            if (before == after)
+                break;
+        }
+
+        __atomic_fetch_add(&group->reader_retries, 1, __ATOMIC_RELAXED);
+    }
+
+    if (before == 0)
+        return ESP_ERR_NOT_FOUND;
+
+    if (age_us != NULL)
+        *age_us = esp_timer_get_time() - frame->trigger_us;
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_group_get_stats(bno055_group_t *group, bno055_group_stats_t *stats)
+{
+    if (group == NULL || stats == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(stats, 0, sizeof(bno055_group_stats_t));
+
+    // Every publish advances the sequence by two
+    stats->frames = __atomic_load_n(&group->seqlock, __ATOMIC_ACQUIRE) / 2;
+    stats->overruns = group->overruns;
+    stats->read_errors = group->read_errors;
+    stats->reader_retries = group->reader_retries;
+    stats->last_skew_us = group->last_skew_us;
+    stats->max_skew_us = group->max_skew_us;
+    stats->mean_skew_us = stats->frames ? (uint32_t)(group->total_skew_us / stats->frames) : 0;
+    stats->max_duration_us = group->max_duration_us;
+    for (size_t bus = 0; bus < group->bus_count; bus++)
+        stats->max_bus_us[bus] = group->buses[bus].max_bus_us;
+
+    return ESP_OK;
+}
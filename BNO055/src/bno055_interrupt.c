@@ -0,0 +1,240 @@
+#include <string.h>
+#include "bno055_interrupt.h"
+
+static void IRAM_ATTR interrupt_isr_handler(void *arg)
+{
+    bno055_interrupt_t *interrupt = (bno055_interrupt_t *)arg;
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    // INT stays high until RST_INT, masked here and unmasked by the event task once reset
+    gpio_intr_disable(interrupt->int_io);
+    interrupt->timestamp_us = esp_timer_get_time();
+
+    vTaskNotifyGiveFromISR(interrupt->task, &higher_priority_task_woken);
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+static void interrupt_task(void *arg)
+{
+    bno055_interrupt_t *interrupt = (bno055_interrupt_t *)arg;
+    bno055_interrupt_event_t event;
+
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!interrupt->running)
+            break;
+
+        event.timestamp_us = interrupt->timestamp_us;
+        event.sequence = interrupt->events++;
+        event.status = 0x00;
+
+        // The bus is only touched here, never in the ISR; the lock keeps the status read and its reset together
+        bno055_lock(interrupt->imu);
+        esp_err_t ret = bno055_read_registers(interrupt->slave_handle, interrupt->imu, 0, INT_STA, &event.status, sizeof(event.status));
+        if (ret == ESP_OK)
+            ret = bno055_reset_interrupts(interrupt->slave_handle, interrupt->imu);
+        bno055_unlock(interrupt->imu);
+        if (ret != ESP_OK)
+            ESP_LOGE("BNO_INT", "Failed to read and reset interrupt status. Error: %s", esp_err_to_name(ret));
+
+        gpio_intr_enable(interrupt->int_io);
+
+        ESP_LOGV("BNO_INT", "Interrupt status '0x%x'", event.status);
+        if (interrupt->queue != NULL && xQueueSend(interrupt->queue, &event, 0) != pdTRUE)
+            interrupt->dropped++;
+        if (interrupt->callback != NULL)
+            interrupt->callback(&event, interrupt->callback_arg);
+    }
+
+    interrupt->task = NULL;
+    vTaskDelete(NULL);
+}
+
+static esp_err_t write_interrupt_config(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const uint8_t *register_content, size_t length)
+{
+    bno055_operation_mode_t previous_mode;
+
+    // Page 1 settings only take effect when written in CONFIG mode
+    esp_err_t ret = bno055_enter_config_mode(slave_handle, imu, &previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = bno055_write_registers(slave_handle, imu, 1, INT_MSK, register_content, length);
+    if (ret != ESP_OK)
+        return ret;
+
+    return bno055_set_operation_mode(slave_handle, imu, previous_mode);
+}
+
+static esp_err_t write_interrupt_registers(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const uint8_t *register_content, size_t length)
+{
+    // No other task may read or reconfigure the device between CONFIG mode and the restored mode
+    bno055_lock(imu);
+    esp_err_t ret = write_interrupt_config(slave_handle, imu, register_content, length);
+    bno055_unlock(imu);
+    return ret;
+}
+
+esp_err_t bno055_interrupt_init_default_config(bno055_interrupt_config_t *interrupt_config)
+{
+    if (interrupt_config == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(interrupt_config, 0, sizeof(bno055_interrupt_config_t));
+
+    // Datasheet reset values, except the axis enables: ACC_INT_SETTINGS and GYR_INT_SETTING reset with every axis off,
+    // which would keep an enabled source from ever firing
+    interrupt_config->int_io = GPIO_NUM_NC;
+    interrupt_config->acc_motion_axes = BNO055_AXIS_ALL;
+    interrupt_config->acc_any_motion_threshold = 0x14;
+    interrupt_config->acc_any_motion_duration = 0x03;
+    interrupt_config->acc_no_motion_threshold = 0x0a;
+    interrupt_config->acc_no_motion_duration = 0x05;
+    interrupt_config->acc_high_g_axes = BNO055_AXIS_ALL;
+    interrupt_config->acc_high_g_threshold = 0xc0;
+    interrupt_config->acc_high_g_duration = 0x0f;
+    interrupt_config->gyr_any_motion_axes = BNO055_AXIS_ALL;
+    interrupt_config->gyr_any_motion_threshold = 0x04;
+    interrupt_config->gyr_any_motion_samples = 0x02;
+    interrupt_config->gyr_any_motion_awake = 0x02;
+    interrupt_config->gyr_high_rate_axes = BNO055_AXIS_ALL;
+    interrupt_config->gyr_high_rate_threshold = 0x01;
+    interrupt_config->gyr_high_rate_duration = 0x19;
+    interrupt_config->task_priority = 5;
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_interrupt_start(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_interrupt_config_t *interrupt_config, bno055_interrupt_t *interrupt)
+{
+    esp_err_t ret;
+    uint8_t gyr_high_rate, register_content[GYR_AM_SET - INT_MSK + 1] = {0};
+
+    if (imu == NULL || (slave_handle == NULL && imu->transport.type == I2C_TRANSPORT) || interrupt_config == NULL || interrupt == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    if (!GPIO_IS_VALID_GPIO(interrupt_config->int_io) || interrupt_config->sources == 0 || (interrupt_config->queue == NULL && interrupt_config->callback == NULL))
+    {
+        ESP_LOGE("BNO_INT", "Invalid interrupt configuration");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // INT_MSK through GYR_AM_SET are contiguous on page 1, so every engine is set up in one burst
+    register_content[INT_MSK - INT_MSK] = interrupt_config->sources;
+    register_content[INT_EN - INT_MSK] = interrupt_config->sources;
+    register_content[ACC_AM_THRES - INT_MSK] = interrupt_config->acc_any_motion_threshold;
+    register_content[ACC_INT_SETTINGS - INT_MSK] = (interrupt_config->acc_any_motion_duration & 0x03) | ((interrupt_config->acc_motion_axes & 0x07) << 2) | ((interrupt_config->acc_high_g_axes & 0x07) << 5);
+    register_content[ACC_HG_DURATION - INT_MSK] = interrupt_config->acc_high_g_duration;
+    register_content[ACC_HG_THRES - INT_MSK] = interrupt_config->acc_high_g_threshold;
+    register_content[ACC_NM_THRES - INT_MSK] = interrupt_config->acc_no_motion_threshold;
+    register_content[ACC_NM_SET - INT_MSK] = (interrupt_config->acc_slow_motion ? 0x00 : 0x01) | ((interrupt_config->acc_no_motion_duration & 0x3f) << 1);
+    register_content[GYR_INT_SETTING - INT_MSK] = (interrupt_config->gyr_any_motion_axes & 0x07) | ((interrupt_config->gyr_high_rate_axes & 0x07) << 3);
+
+    // Same high-rate threshold and duration on every axis
+    gyr_high_rate = (interrupt_config->gyr_high_rate_threshold & 0x1f) | ((interrupt_config->gyr_high_rate_hysteresis & 0x03) << 5);
+    register_content[GYR_HR_X_SET - INT_MSK] = gyr_high_rate;
+    register_content[GYR_DUR_X - INT_MSK] = interrupt_config->gyr_high_rate_duration;
+    register_content[GYR_HR_Y_SET - INT_MSK] = gyr_high_rate;
+    register_content[GYR_DUR_Y - INT_MSK] = interrupt_config->gyr_high_rate_duration;
+    register_content[GYR_HR_Z_SET - INT_MSK] = gyr_high_rate;
+    register_content[GYR_DUR_Z - INT_MSK] = interrupt_config->gyr_high_rate_duration;
+    register_content[GYR_AM_THRES - INT_MSK] = interrupt_config->gyr_any_motion_threshold;
+    register_content[GYR_AM_SET - INT_MSK] = (interrupt_config->gyr_any_motion_samples & 0x03) | ((interrupt_config->gyr_any_motion_awake & 0x03) << 2);
+
+    memset(interrupt, 0, sizeof(bno055_interrupt_t));
+    interrupt->slave_handle = slave_handle;
+    interrupt->imu = imu;
+    interrupt->int_io = interrupt_config->int_io;
+    interrupt->queue = interrupt_config->queue;
+    interrupt->callback = interrupt_config->callback;
+    interrupt->callback_arg = interrupt_config->callback_arg;
+
+    ret = write_interrupt_registers(slave_handle, imu, register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    // Start from a released INT pin
+    ret = bno055_reset_interrupts(slave_handle, imu);
+    if (ret != ESP_OK)
+        return ret;
+
+    interrupt->running = true;
+    if (xTaskCreatePinnedToCore(interrupt_task, "bno055_int", BNO055_INTERRUPT_TASK_STACK, interrupt, interrupt_config->task_priority, &interrupt->task, tskNO_AFFINITY) != pdPASS)
+    {
+        interrupt->running = false;
+        return ESP_ERR_NO_MEM;
+    }
+
+    // INT is push-pull active high; a level interrupt cannot miss an edge and can wake light sleep
+    gpio_config_t io_config = {
+        .pin_bit_mask = (1ULL << interrupt->int_io),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_ENABLE,
+        .intr_type = GPIO_INTR_HIGH_LEVEL,
+    };
+    ret = gpio_config(&io_config);
+
+    // ESP_ERR_INVALID_STATE means the service is already installed
+    if (ret == ESP_OK)
+    {
+        ret = gpio_install_isr_service(0);
+        if (ret == ESP_ERR_INVALID_STATE)
+            ret = ESP_OK;
+    }
+
+    if (ret == ESP_OK)
+        ret = gpio_isr_handler_add(interrupt->int_io, interrupt_isr_handler, interrupt);
+
+    if (ret == ESP_OK && interrupt_config->light_sleep_wake)
+    {
+        ret = gpio_wakeup_enable(interrupt->int_io, GPIO_INTR_HIGH_LEVEL);
+        if (ret == ESP_OK)
+            ret = esp_sleep_enable_gpio_wakeup();
+        interrupt->light_sleep_wake = (ret == ESP_OK);
+    }
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE("BNO_INT", "Failed to attach INT to GPIO %d. Error: %s", interrupt->int_io, esp_err_to_name(ret));
+        bno055_interrupt_stop(interrupt);
+        return ret;
+    }
+
+    ESP_LOGD("BNO_INT", "Interrupts '0x%x' armed on GPIO %d", interrupt_config->sources, interrupt->int_io);
+    return ESP_OK;
+}
+
+esp_err_t bno055_interrupt_stop(bno055_interrupt_t *interrupt)
+{
+    uint8_t register_content[2] = {0x00, 0x00};
+
+    if (interrupt == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    if (!interrupt->running)
+        return ESP_ERR_INVALID_STATE;
+
+    gpio_set_intr_type(interrupt->int_io, GPIO_INTR_DISABLE);
+    if (interrupt->light_sleep_wake)
+    {
+        gpio_wakeup_disable(interrupt->int_io);
+        interrupt->light_sleep_wake = false;
+    }
+    gpio_isr_handler_remove(interrupt->int_io);
+
+    // Let the event task finish its current event and exit
+    interrupt->running = false;
+    if (interrupt->task != NULL)
+        xTaskNotifyGive(interrupt->task);
+    for (size_t i = 0; i < 100 && interrupt->task != NULL; i++)
+        vTaskDelay(pdMS_TO_TICKS(10) > 0 ? pdMS_TO_TICKS(10) : 1);
+
+    // Mask and disable every engine on the device
+    esp_err_t ret = write_interrupt_registers(interrupt->slave_handle, interrupt->imu, register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    return bno055_reset_interrupts(interrupt->slave_handle, interrupt->imu);
+}
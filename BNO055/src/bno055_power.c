@@ -0,0 +1,119 @@
+#include <string.h>
+#include "bno055_power.h"
+
+// ACC_NM_SET duration field: 1 - 16 s in 1 s steps, 20 - 80 s in 4 s steps, 88 - 336 s in 8 s steps
+static uint8_t encode_no_motion_duration(uint16_t duration_s)
+{
+    if (duration_s <= 16)
+        return duration_s > 0 ? duration_s - 1 : 0;
+
+    if (duration_s <= 80)
+        return 0x10 | ((duration_s - 20 + 3) / 4);
+
+    return 0x20 | ((duration_s - 88 + 7) / 8);
+}
+
+esp_err_t bno055_power_init_default_config(bno055_power_config_t *power_config)
+{
+    if (power_config == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(power_config, 0, sizeof(bno055_power_config_t));
+
+    // Datasheet reset values, only the power mode differs
+    power_config->power_mode = LOW_POWER_MODE;
+    power_config->no_motion_threshold = 0x0a;
+    power_config->no_motion_duration_s = 6;
+    power_config->any_motion_threshold = 0x14;
+    power_config->acc_sleep_duration = 0x05;
+    power_config->gyr_sleep_duration = 0x00;
+    power_config->gyr_auto_sleep_duration = 0x01;
+
+    return ESP_OK;
+}
+
+static esp_err_t configure_power(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_power_config_t *power_config)
+{
+    bno055_operation_mode_t previous_mode;
+
+    if (imu == NULL || power_config == NULL || power_config->power_mode > SUSPEND_MODE ||
+        power_config->no_motion_duration_s == 0 || power_config->no_motion_duration_s > 336 ||
+        power_config->acc_sleep_duration > 15 || power_config->gyr_sleep_duration > 7 ||
+        power_config->gyr_auto_sleep_duration == 0 || power_config->gyr_auto_sleep_duration > 7)
+        return ESP_ERR_INVALID_ARG;
+
+    uint8_t sleep_content[GYR_SLEEP_CONFIG - ACC_SLEEP_CONFIG + 1] = {
+        (uint8_t)((power_config->acc_sleep_duration << 1) | (power_config->acc_equidistant_sampling ? 0x01 : 0x00)),
+        (uint8_t)((power_config->gyr_auto_sleep_duration << 3) | power_config->gyr_sleep_duration)};
+    // ACC_NM_SET bit 0 selects no-motion rather than slow-motion detection
+    uint8_t no_motion_content[ACC_NM_SET - ACC_NM_THRES + 1] = {
+        power_config->no_motion_threshold,
+        (uint8_t)((encode_no_motion_duration(power_config->no_motion_duration_s) << 1) | 0x01)};
+
+    // Page 1 settings only take effect when written in CONFIG mode
+    esp_err_t ret = bno055_enter_config_mode(slave_handle, imu, &previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = bno055_write_registers(slave_handle, imu, 1, ACC_SLEEP_CONFIG, sleep_content, sizeof(sleep_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = bno055_write_registers(slave_handle, imu, 1, ACC_AM_THRES, &power_config->any_motion_threshold, sizeof(power_config->any_motion_threshold));
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = bno055_write_registers(slave_handle, imu, 1, ACC_NM_THRES, no_motion_content, sizeof(no_motion_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = bno055_set_operation_mode(slave_handle, imu, previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    ESP_LOGD("BNO_POWER", "Power mode '%d', sleep after %d s without motion", power_config->power_mode, power_config->no_motion_duration_s);
+    return bno055_power_mode_set(slave_handle, imu, power_config->power_mode);
+}
+
+esp_err_t bno055_power_configure(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_power_config_t *power_config)
+{
+    bno055_lock(imu);
+    esp_err_t ret = configure_power(slave_handle, imu, power_config);
+    bno055_unlock(imu);
+    return ret;
+}
+
+esp_err_t bno055_power_wake(i2c_master_dev_handle_t *slave_handle, imu_t *imu, uint16_t sensor_mask, bno055_wake_latency_t *latency)
+{
+    bno055_read_plan_t plan;
+
+    if (imu == NULL || latency == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(latency, 0, sizeof(bno055_wake_latency_t));
+
+    esp_err_t ret = bno055_plan_readings(sensor_mask, BNO055_TRANSACTION_OVERHEAD_BYTES, &plan);
+    if (ret != ESP_OK)
+        return ret;
+
+    // Held across the measurement so no other access lands between the wake-up and the first read
+    bno055_lock(imu);
+
+    // Returns once SYS_STATUS reports the running mode again, the sensors are sampling from then on
+    int64_t start = esp_timer_get_time();
+    ret = bno055_power_mode_set(slave_handle, imu, NORMAL_MODE);
+    if (ret == ESP_OK)
+    {
+        latency->transition_us = (uint32_t)(esp_timer_get_time() - start);
+
+        ret = bno055_get_planned_readings(slave_handle, imu, &plan);
+        latency->first_sample_us = (uint32_t)(esp_timer_get_time() - start);
+    }
+
+    bno055_unlock(imu);
+    if (ret != ESP_OK)
+        return ret;
+
+    ESP_LOGD("BNO_POWER", "Awake in %d us, first sample after %d us", (int)latency->transition_us, (int)latency->first_sample_us);
+    return ESP_OK;
+}
@@ -0,0 +1,306 @@
+#include <string.h>
+#include "bno055_raw.h"
+
+static const uint8_t acc_range_g[] = {2, 4, 8, 16};
+static const uint16_t gyr_range_dps[] = {2000, 1000, 500, 250, 125};
+
+static bool valid_settings(const bno055_sensor_settings_t *settings)
+{
+    return settings->acc_range <= ACC_RANGE_16G && settings->acc_bandwidth <= ACC_BW_1000HZ &&
+           settings->acc_power <= ACC_PWR_DEEP_SUSPEND && settings->mag_rate <= MAG_ODR_30HZ &&
+           settings->mag_operation <= MAG_OPR_HIGH_ACCURACY && settings->mag_power <= MAG_PWR_FORCE &&
+           settings->gyr_range <= GYR_RANGE_125DPS && settings->gyr_bandwidth <= GYR_BW_32HZ &&
+           settings->gyr_power <= GYR_PWR_ADVANCED_POWERSAVE;
+}
+
+static void set_ranges(imu_t *imu, const bno055_sensor_settings_t *settings)
+{
+    imu->bno055_config.accel_range_g = acc_range_g[settings->acc_range];
+    imu->bno055_config.gyro_range_dps = gyr_range_dps[settings->gyr_range];
+    bno055_refresh_sensor_scale(imu);
+}
+
+static esp_err_t write_sensor_settings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_sensor_settings_t *settings)
+{
+    bno055_operation_mode_t previous_mode;
+
+    if (imu == NULL || settings == NULL || !valid_settings(settings))
+        return ESP_ERR_INVALID_ARG;
+
+    // ACC_CONFIG, MAG_CONFIG, GYR_CONFIG_0 and GYR_CONFIG_1 are adjacent on page 1
+    uint8_t register_content[GYR_CONFIG_1 - ACC_CONFIG + 1] = {
+        (uint8_t)((settings->acc_power << 5) | (settings->acc_bandwidth << 2) | settings->acc_range),
+        (uint8_t)((settings->mag_power << 5) | (settings->mag_operation << 3) | settings->mag_rate),
+        (uint8_t)((settings->gyr_bandwidth << 3) | settings->gyr_range),
+        (uint8_t)settings->gyr_power};
+
+    // Page 1 settings only take effect when written in CONFIG mode
+    esp_err_t ret = bno055_enter_config_mode(slave_handle, imu, &previous_mode);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = bno055_write_registers(slave_handle, imu, 1, ACC_CONFIG, register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    set_ranges(imu, settings);
+
+    // The fusion modes reconfigure the sensors themselves when they are entered
+    if (previous_mode >= IMU_MODE)
+        ESP_LOGW("BNO_CONFIG", "Sensor settings are overridden by fusion mode '%d'", previous_mode);
+
+    ESP_LOGD("BNO_CONFIG", "Sensor settings '0x%02x 0x%02x 0x%02x 0x%02x' written", register_content[0], register_content[1], register_content[2], register_content[3]);
+    return bno055_set_operation_mode(slave_handle, imu, previous_mode);
+}
+
+esp_err_t bno055_set_sensor_settings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_sensor_settings_t *settings)
+{
+    // Held across the CONFIG round trip, so a sampler never reads the device mid-reconfiguration
+    bno055_lock(imu);
+    esp_err_t ret = write_sensor_settings(slave_handle, imu, settings);
+    bno055_unlock(imu);
+    return ret;
+}
+
+esp_err_t bno055_get_sensor_settings(i2c_master_dev_handle_t *slave_handle, imu_t *imu, bno055_sensor_settings_t *settings)
+{
+    uint8_t register_content[GYR_CONFIG_1 - ACC_CONFIG + 1] = {0};
+
+    if (imu == NULL || settings == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = bno055_read_registers(slave_handle, imu, 1, ACC_CONFIG, register_content, sizeof(register_content));
+    if (ret != ESP_OK)
+        return ret;
+
+    settings->acc_range = register_content[0] & 0x03;
+    settings->acc_bandwidth = (register_content[0] >> 2) & 0x07;
+    settings->acc_power = (register_content[0] >> 5) & 0x07;
+    settings->mag_rate = register_content[1] & 0x07;
+    settings->mag_operation = (register_content[1] >> 3) & 0x03;
+    settings->mag_power = (register_content[1] >> 5) & 0x03;
+    settings->gyr_range = register_content[2] & 0x07;
+    settings->gyr_bandwidth = (register_content[2] >> 3) & 0x07;
+    settings->gyr_power = register_content[3] & 0x07;
+
+    // Codes 5 - 7 of the gyroscope range are reserved
+    if (settings->gyr_range > GYR_RANGE_125DPS)
+        return ESP_ERR_INVALID_RESPONSE;
+
+    set_ranges(imu, settings);
+    return ESP_OK;
+}
+
+static void raw_stream_timer_callback(void *arg)
+{
+    bno055_raw_stream_t *stream = (bno055_raw_stream_t *)arg;
+
+    xTaskNotifyGive(stream->task);
+}
+
+static void raw_stream_task(void *arg)
+{
+    bno055_raw_stream_t *stream = (bno055_raw_stream_t *)arg;
+    uint8_t register_content[GYR_DATA_Z_MSB - ACC_DATA_X_LSB + 1];
+    // Same register order as the sample: accelerometer, magnetometer, gyroscope
+    int16_t data[9] = {0};
+    size_t first = (stream->span.register_address - ACC_DATA_X_LSB) / 2;
+
+    while (1)
+    {
+        uint32_t pending = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (stream->stop_requested)
+            break;
+
+        // Every give beyond the first is a period that found the task still reading
+        if (pending > 1)
+            stream->missed += pending - 1;
+
+        int64_t start = esp_timer_get_time();
+        esp_err_t ret = bno055_read_registers(stream->slave_handle, stream->imu, 0, stream->span.register_address, register_content, stream->span.length);
+        int64_t end = esp_timer_get_time();
+
+        if ((uint32_t)(end - start) > stream->max_read_us)
+            stream->max_read_us = (uint32_t)(end - start);
+
+        if (ret != ESP_OK)
+        {
+            stream->read_errors++;
+            continue;
+        }
+
+        uint32_t head = __atomic_load_n(&stream->head, __ATOMIC_RELAXED);
+        if (head - __atomic_load_n(&stream->tail, __ATOMIC_ACQUIRE) > stream->index_mask)
+        {
+            stream->overruns++;
+            continue;
+        }
+
+        for (size_t i = 0; i < stream->span.length / 2; i++)
+            data[first + i] = (int16_t)((register_content[2 * i + 1] << 8) | register_content[2 * i]);
+
+        bno055_raw_sample_t *sample = &stream->buffer[head & stream->index_mask];
+        for (size_t i = 0; i < 3; i++)
+        {
+            sample->accel[i] = (stream->sensor_mask & ACCELEROMETER_MASK) ? data[i] : 0;
+            sample->mag[i] = (stream->sensor_mask & MAGNETOMETER_MASK) ? data[3 + i] : 0;
+            sample->gyro[i] = (stream->sensor_mask & GYROSCOPE_MASK) ? data[6 + i] : 0;
+        }
+        sample->timestamp_us = end;
+
+        __atomic_store_n(&stream->head, head + 1, __ATOMIC_RELEASE);
+    }
+
+    stream->running = false;
+    vTaskDelete(NULL);
+}
+
+esp_err_t bno055_raw_stream_init_default_config(bno055_raw_stream_config_t *stream_config)
+{
+    if (stream_config == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(stream_config, 0, sizeof(bno055_raw_stream_config_t));
+    stream_config->sensor_mask = ACCELEROMETER_MASK | GYROSCOPE_MASK;
+    stream_config->rate_hz = 1000;
+    stream_config->task_priority = 10;
+    stream_config->core_id = tskNO_AFFINITY;
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_raw_stream_start(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_raw_stream_config_t *stream_config, bno055_raw_stream_t *stream)
+{
+    static const uint8_t first_register[] = {ACC_DATA_X_LSB, MAG_DATA_X_LSB, GYR_DATA_X_LSB};
+    uint16_t sensor_mask;
+
+    if (imu == NULL || (slave_handle == NULL && imu->transport.type == I2C_TRANSPORT) || stream_config == NULL || stream == NULL || stream_config->buffer == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    sensor_mask = stream_config->sensor_mask & (ACCELEROMETER_MASK | MAGNETOMETER_MASK | GYROSCOPE_MASK);
+    if (sensor_mask == 0 || sensor_mask != stream_config->sensor_mask || stream_config->capacity == 0 ||
+        (stream_config->capacity & (stream_config->capacity - 1)) != 0 ||
+        stream_config->rate_hz == 0 || stream_config->rate_hz > BNO055_RAW_STREAM_MAX_RATE_HZ)
+    {
+        ESP_LOGE("BNO_RAW", "Invalid raw stream configuration");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(stream, 0, sizeof(bno055_raw_stream_t));
+    stream->slave_handle = slave_handle;
+    stream->imu = imu;
+    stream->sensor_mask = sensor_mask;
+    stream->buffer = stream_config->buffer;
+    stream->index_mask = stream_config->capacity - 1;
+
+    // One burst from the first to the last selected sensor, the three blocks are adjacent
+    size_t first = __builtin_ctz(sensor_mask);
+    size_t last = 31 - __builtin_clz(sensor_mask);
+    stream->span.register_address = first_register[first];
+    stream->span.length = first_register[last] + 6 - first_register[first];
+
+    stream->running = true;
+    if (xTaskCreatePinnedToCore(raw_stream_task, "bno055_raw", BNO055_RAW_STREAM_TASK_STACK, stream, stream_config->task_priority, &stream->task, stream_config->core_id) != pdPASS)
+    {
+        stream->running = false;
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = raw_stream_timer_callback,
+        .arg = stream,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "bno055_raw"};
+
+    esp_err_t ret = esp_timer_create(&timer_args, &stream->timer);
+    if (ret == ESP_OK)
+        ret = esp_timer_start_periodic(stream->timer, 1000000 / stream_config->rate_hz);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE("BNO_RAW", "Failed to start the stream timer: %s", esp_err_to_name(ret));
+        (void)bno055_raw_stream_stop(stream);
+        return ret;
+    }
+
+    ESP_LOGD("BNO_RAW", "Streaming mask '0x%x' at %d Hz (%d bytes per burst)", sensor_mask, (int)stream_config->rate_hz, stream->span.length);
+    return ESP_OK;
+}
+
+esp_err_t bno055_raw_stream_stop(bno055_raw_stream_t *stream)
+{
+    if (stream == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    if (!stream->running)
+        return ESP_ERR_INVALID_STATE;
+
+    if (stream->timer != NULL)
+    {
+        (void)esp_timer_stop(stream->timer);
+        (void)esp_timer_delete(stream->timer);
+        stream->timer = NULL;
+    }
+
+    // The task exits after its current read
+    stream->stop_requested = true;
+    xTaskNotifyGive(stream->task);
+    for (size_t i = 0; i < 100 && stream->running; i++)
+        vTaskDelay(1);
+
+    return stream->running ? ESP_ERR_TIMEOUT : ESP_OK;
+}
+
+size_t bno055_raw_stream_read(bno055_raw_stream_t *stream, bno055_raw_sample_t *samples, size_t max_samples)
+{
+    if (stream == NULL || samples == NULL)
+        return 0;
+
+    uint32_t tail = __atomic_load_n(&stream->tail, __ATOMIC_RELAXED);
+    uint32_t available = __atomic_load_n(&stream->head, __ATOMIC_ACQUIRE) - tail;
+    size_t count = (available < max_samples) ? available : max_samples;
+
+    for (size_t i = 0; i < count; i++)
+        samples[i] = stream->buffer[(tail + i) & stream->index_mask];
+
+    __atomic_store_n(&stream->tail, tail + count, __ATOMIC_RELEASE);
+    return count;
+}
+
+esp_err_t bno055_raw_stream_get_stats(bno055_raw_stream_t *stream, bno055_raw_stream_stats_t *stats)
+{
+    if (stream == NULL || stats == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    stats->samples = __atomic_load_n(&stream->head, __ATOMIC_ACQUIRE);
+    stats->overruns = stream->overruns;
+    stats->missed = stream->missed;
+    stats->read_errors = stream->read_errors;
+    stats->max_read_us = stream->max_read_us;
+
+    return ESP_OK;
+}
+
+void bno055_raw_sample_to_vectors(const imu_t *imu, const bno055_raw_sample_t *sample, vector_t *accel, vector_t *mag, vector_t *gyro)
+{
+    const scale_t *scale = &imu->bno055_config.sensor_scale;
+
+    if (accel != NULL)
+    {
+        accel->x = sample->accel[0] / scale->accel;
+        accel->y = sample->accel[1] / scale->accel;
+        accel->z = sample->accel[2] / scale->accel;
+    }
+    if (mag != NULL)
+    {
+        mag->x = sample->mag[0] / scale->mag;
+        mag->y = sample->mag[1] / scale->mag;
+        mag->z = sample->mag[2] / scale->mag;
+    }
+    if (gyro != NULL)
+    {
+        gyro->x = sample->gyro[0] / scale->gyro;
+        gyro->y = sample->gyro[1] / scale->gyro;
+        gyro->z = sample->gyro[2] / scale->gyro;
+    }
+}
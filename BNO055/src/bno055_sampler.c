@@ -0,0 +1,181 @@
+#include <string.h>
+#include "bno055_sampler.h"
+
+static void publish_snapshot(bno055_sampler_t *sampler, const bno055_snapshot_t *snapshot)
+{
+    // The critical section only keeps the writer from being preempted mid-copy,
+    // so a reader on the same core can never spin on an odd sequence
+    portENTER_CRITICAL(&sampler->write_lock);
+    uint32_t sequence = __atomic_load_n(&sampler->seqlock, __ATOMIC_RELAXED);
+    __atomic_store_n(&sampler->seqlock, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(&sampler->snapshot, snapshot, sizeof(bno055_snapshot_t));
+    __atomic_store_n(&sampler->seqlock, sequence + 2, __ATOMIC_RELEASE);
+    portEXIT_CRITICAL(&sampler->write_lock);
+}
+
+static void sampler_task(void *arg)
+{
+    bno055_sampler_t *sampler = (bno055_sampler_t *)arg;
+    bno055_snapshot_t snapshot = {0};
+    TickType_t last_wake = xTaskGetTickCount();
+
+    while (!sampler->stop_requested)
+    {
+        // Held until the copy is done, so another task sharing the imu_t cannot overwrite it in between
+        bno055_lock(sampler->imu);
+
+        int64_t start = esp_timer_get_time();
+        esp_err_t ret = bno055_get_planned_readings(sampler->slave_handle, sampler->imu, &sampler->plan);
+        int64_t end = esp_timer_get_time();
+
+        if (ret == ESP_OK)
+        {
+            snapshot.raw_acceleration = sampler->imu->raw_acceleration;
+            snapshot.gyroscope = sampler->imu->gyroscope;
+            snapshot.magnetometer = sampler->imu->magnetometer;
+            snapshot.euler_angles = sampler->imu->euler_angles;
+            snapshot.quaternion = sampler->imu->quaternion;
+            snapshot.linear_acceleration = sampler->imu->linear_acceleration;
+            snapshot.gravity = sampler->imu->gravity;
+            snapshot.temperature = sampler->imu->temperature;
+            snapshot.calibration_status = sampler->imu->calibration_status;
+        }
+
+        bno055_unlock(sampler->imu);
+
+        sampler->last_read_us = (uint32_t)(end - start);
+        if (sampler->last_read_us > sampler->max_read_us)
+            sampler->max_read_us = sampler->last_read_us;
+
+        if (ret == ESP_OK)
+        {
+            snapshot.timestamp_us = end;
+            snapshot.sequence++;
+            publish_snapshot(sampler, &snapshot);
+        }
+        else
+        {
+            sampler->read_errors++;
+        }
+
+        // pdFALSE means the next deadline had already passed
+        if (xTaskDelayUntil(&last_wake, sampler->period) == pdFALSE)
+            sampler->overruns++;
+    }
+
+    sampler->running = false;
+    vTaskDelete(NULL);
+}
+
+esp_err_t bno055_sampler_init_default_config(bno055_sampler_config_t *sampler_config)
+{
+    if (sampler_config == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    memset(sampler_config, 0, sizeof(bno055_sampler_config_t));
+    sampler_config->sensor_mask = QUATERNION_MASK | LINEAR_ACCELERATION_MASK | GRAVITY_MASK;
+    sampler_config->period_ms = 10;
+    sampler_config->task_priority = 5;
+    sampler_config->core_id = tskNO_AFFINITY;
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_sampler_start(i2c_master_dev_handle_t *slave_handle, imu_t *imu, const bno055_sampler_config_t *sampler_config, bno055_sampler_t *sampler)
+{
+    if (imu == NULL || (slave_handle == NULL && imu->transport.type == I2C_TRANSPORT) || sampler_config == NULL || sampler == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    TickType_t period = pdMS_TO_TICKS(sampler_config->period_ms);
+    if (period == 0)
+    {
+        ESP_LOGE("BNO_SAMPLER", "Period of %d ms is shorter than one tick", (int)sampler_config->period_ms);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(sampler, 0, sizeof(bno055_sampler_t));
+    sampler->slave_handle = slave_handle;
+    sampler->imu = imu;
+    sampler->period = period;
+    spinlock_initialize(&sampler->write_lock);
+
+    // Planned once, every period is then the same burst reads
+    esp_err_t ret = bno055_plan_readings(sampler_config->sensor_mask, BNO055_TRANSACTION_OVERHEAD_BYTES, &sampler->plan);
+    if (ret != ESP_OK)
+        return ret;
+
+    sampler->running = true;
+    if (xTaskCreatePinnedToCore(sampler_task, "bno055_sampler", BNO055_SAMPLER_TASK_STACK, sampler, sampler_config->task_priority, &sampler->task, sampler_config->core_id) != pdPASS)
+    {
+        sampler->running = false;
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGD("BNO_SAMPLER", "Sampling mask '0x%x' every %d ms (%d bus bytes per sample)", sampler_config->sensor_mask, (int)sampler_config->period_ms, sampler->plan.bus_bytes);
+    return ESP_OK;
+}
+
+esp_err_t bno055_sampler_stop(bno055_sampler_t *sampler)
+{
+    if (sampler == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    if (!sampler->running)
+        return ESP_ERR_INVALID_STATE;
+
+    // The task exits after its current period
+    sampler->stop_requested = true;
+    for (size_t i = 0; i < 100 && sampler->running; i++)
+        vTaskDelay(sampler->period);
+
+    return sampler->running ? ESP_ERR_TIMEOUT : ESP_OK;
+}
+
+esp_err_t bno055_sampler_read(bno055_sampler_t *sampler, bno055_snapshot_t *snapshot, int64_t *age_us)
+{
+    uint32_t before, after;
+
+    if (sampler == NULL || snapshot == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // Lock-free: copy, then retry if a write started or finished in between
+    while (1)
+    {
+        before = __atomic_load_n(&sampler->seqlock, __ATOMIC_ACQUIRE);
+        if ((before & 1) == 0)
+        {
+            memcpy(snapshot, &sampler->snapshot, sizeof(bno055_snapshot_t));
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            after = __atomic_load_n(&sampler->seqlock, __ATOMIC_RELAXED);
+            if (before == after)
+                break;
+        }
+
+        __atomic_fetch_add(&sampler->reader_retries, 1, __ATOMIC_RELAXED);
+    }
+
+    if (before == 0)
+        return ESP_ERR_NOT_FOUND;
+
+    if (age_us != NULL)
+        *age_us = esp_timer_get_time() - snapshot->timestamp_us;
+
+    return ESP_OK;
+}
+
+esp_err_t bno055_sampler_get_stats(bno055_sampler_t *sampler, bno055_sampler_stats_t *stats)
+{
+    if (sampler == NULL || stats == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // Every publish advances the sequence by two
+    stats->samples = __atomic_load_n(&sampler->seqlock, __ATOMIC_ACQUIRE) / 2;
+    stats->overruns = sampler->overruns;
+    stats->read_errors = sampler->read_errors;
+    stats->reader_retries = sampler->reader_retries;
+    stats->last_read_us = sampler->last_read_us;
+    stats->max_read_us = sampler->max_read_us;
+
+    return ESP_OK;
+}
@@ -0,0 +1,239 @@
+#include <string.h>
+#include "bno055_transport.h"
+
+static TickType_t transport_timeout(const bno055_transport_t *transport, uint32_t timeout_ms)
+{
+    if (timeout_ms == 0)
+        timeout_ms = transport->timeout_ms;
+
+    if (timeout_ms == 0)
+        timeout_ms = (transport->type == UART_TRANSPORT) ? BNO055_UART_TIMEOUT_MS : BNO055_I2C_TIMEOUT_MS;
+
+    TickType_t ticks = pdMS_TO_TICKS(timeout_ms);
+    return ticks > 0 ? ticks : 1;
+}
+
+static void update_stats(bno055_transport_t *transport, esp_err_t ret, size_t length, int64_t start)
+{
+    uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start);
+
+    if (ret != ESP_OK)
+    {
+        transport->stats.errors++;
+        return;
+    }
+
+    transport->stats.transactions++;
+    transport->stats.bytes += length;
+    transport->stats.total_us += elapsed_us;
+    if (elapsed_us > transport->stats.max_us)
+        transport->stats.max_us = elapsed_us;
+}
+
+// Collects exactly length bytes, woken by the driver's UART_DATA events instead of polling
+static esp_err_t uart_receive(bno055_transport_t *transport, uint8_t *buffer, size_t length, TickType_t deadline)
+{
+    size_t received = 0, buffered = 0;
+    uart_event_t event;
+
+    while (received < length)
+    {
+        // Bytes of an earlier event may still be waiting in the ring buffer
+        if (uart_get_buffered_data_len(transport->uart_port, &buffered) == ESP_OK && buffered > 0)
+        {
+            size_t wanted = length - received;
+            int count = uart_read_bytes(transport->uart_port, &buffer[received], buffered < wanted ? buffered : wanted, 0);
+            if (count < 0)
+                return ESP_FAIL;
+
+            received += count;
+            continue;
+        }
+
+        TickType_t now = xTaskGetTickCount();
+        if ((int32_t)(deadline - now) <= 0 || xQueueReceive(transport->uart_queue, &event, deadline - now) != pdTRUE)
+            return ESP_ERR_TIMEOUT;
+
+        switch (event.type)
+        {
+        case UART_FIFO_OVF:
+        case UART_BUFFER_FULL:
+            // The frame is incomplete, drop it and whatever follows
+            uart_flush_input(transport->uart_port);
+            xQueueReset(transport->uart_queue);
+            return ESP_ERR_INVALID_RESPONSE;
+
+        default:
+            break;
+        }
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t uart_transaction(bno055_transport_t *transport, uint8_t command, uint8_t register_address, uint8_t *register_content, size_t length, TickType_t timeout)
+{
+    uint8_t frame[4 + BNO055_UART_MAX_LENGTH] = {BNO055_UART_START_BYTE, command, register_address, (uint8_t)length};
+    uint8_t header[2];
+    size_t frame_length = 4;
+    esp_err_t ret = ESP_ERR_INVALID_RESPONSE;
+
+    if (command == BNO055_UART_WRITE)
+    {
+        memcpy(&frame[4], register_content, length);
+        frame_length += length;
+    }
+
+    // The chip rejects a frame with BUS_OVER_RUN_ERROR when its own bus is busy, which is worth a retry
+    for (uint32_t attempt = 0; attempt <= BNO055_UART_RETRIES; attempt++)
+    {
+        if (attempt > 0)
+            transport->stats.retries++;
+
+        // A late response of an earlier, timed out frame must not be taken for this one
+        uart_flush_input(transport->uart_port);
+        xQueueReset(transport->uart_queue);
+
+        TickType_t deadline = xTaskGetTickCount() + timeout;
+        if (uart_write_bytes(transport->uart_port, frame, frame_length) != (int)frame_length)
+            return ESP_FAIL;
+
+        ret = uart_receive(transport, header, sizeof(header), deadline);
+        if (ret != ESP_OK)
+            return ret;
+
+        if (command == BNO055_UART_READ && header[0] == BNO055_UART_READ_RESPONSE)
+        {
+            if (header[1] != length)
+                return ESP_ERR_INVALID_RESPONSE;
+
+            return uart_receive(transport, register_content, length, deadline);
+        }
+
+        if (header[0] != BNO055_UART_STATUS_RESPONSE)
+            return ESP_ERR_INVALID_RESPONSE;
+
+        if (command == BNO055_UART_WRITE && header[1] == BNO055_UART_WRITE_SUCCESS)
+            return ESP_OK;
+
+        if (header[1] != BNO055_UART_BUS_OVER_RUN_ERROR)
+        {
+            ESP_LOGE("UART", "Register '0x%x' %s failed with status '0x%x'", register_address, command == BNO055_UART_READ ? "read" : "write", header[1]);
+            return ESP_FAIL;
+        }
+    }
+
+    ESP_LOGE("UART", "Register '0x%x' still busy after %d retries", register_address, BNO055_UART_RETRIES);
+    return ESP_FAIL;
+}
+
+esp_err_t bno055_transport_uart_init(bno055_transport_t *transport, const bno055_uart_config_t *uart_config)
+{
+    if (transport == NULL || uart_config == NULL)
+        return ESP_ERR_INVALID_ARG;
+
+    // 115200 8N1 is fixed by the chip
+    const uart_config_t config = {
+        .baud_rate = BNO055_UART_BAUD_RATE,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT};
+
+    esp_err_t ret = uart_param_config(uart_config->port, &config);
+    if (ret != ESP_OK)
+        return ret;
+
+    ret = uart_set_pin(uart_config->port, uart_config->tx_io, uart_config->rx_io, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    if (ret != ESP_OK)
+        return ret;
+
+    memset(transport, 0, sizeof(bno055_transport_t));
+    ret = uart_driver_install(uart_config->port, BNO055_UART_RX_BUFFER_SIZE, 0, BNO055_UART_QUEUE_SIZE, &transport->uart_queue, 0);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE("UART", "Failed to install the UART driver. Error: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    transport->type = UART_TRANSPORT;
+    transport->uart_port = uart_config->port;
+    transport->timeout_ms = uart_config->timeout_ms;
+
+    ESP_LOGD("UART", "BNO055 on UART %d (TX %d, RX %d)", uart_config->port, uart_config->tx_io, uart_config->rx_io);
+    return ESP_OK;
+}
+
+esp_err_t bno055_transport_uart_deinit(bno055_transport_t *transport)
+{
+    if (transport == NULL || transport->type != UART_TRANSPORT)
+        return ESP_ERR_INVALID_ARG;
+
+    esp_err_t ret = uart_driver_delete(transport->uart_port);
+    if (ret != ESP_OK)
+        return ret;
+
+    memset(transport, 0, sizeof(bno055_transport_t));
+    return ESP_OK;
+}
+
+esp_err_t bno055_transport_read(i2c_master_dev_handle_t *slave_handle, bno055_transport_t *transport, uint8_t register_address, uint8_t *register_content, size_t length, uint32_t timeout_ms)
+{
+    esp_err_t ret;
+    int64_t start = esp_timer_get_time();
+
+    if (transport == NULL || length == 0 || length > BNO055_UART_MAX_LENGTH)
+        return ESP_ERR_INVALID_ARG;
+
+    if (transport->type == UART_TRANSPORT)
+    {
+        ret = uart_transaction(transport, BNO055_UART_READ, register_address, register_content, length, transport_timeout(transport, timeout_ms));
+    }
+    else
+    {
+        if (slave_handle == NULL)
+            return ESP_ERR_INVALID_ARG;
+
+        // The register address auto-increments, so a single transaction reads the whole span
+        ret = i2c_master_transmit_receive(*slave_handle, &register_address, sizeof(register_address), register_content, length, transport_timeout(transport, timeout_ms));
+    }
+
+    update_stats(transport, ret, length, start);
+    return ret;
+}
+
+esp_err_t bno055_transport_write(i2c_master_dev_handle_t *slave_handle, bno055_transport_t *transport, uint8_t register_address, const uint8_t *register_content, size_t length, uint32_t timeout_ms)
+{
+    esp_err_t ret;
+    int64_t start = esp_timer_get_time();
+
+    if (transport == NULL || length == 0 || length > BNO055_UART_MAX_LENGTH)
+        return ESP_ERR_INVALID_ARG;
+
+    if (transport->type == UART_TRANSPORT)
+    {
+        ret = uart_transaction(transport, BNO055_UART_WRITE, register_address, (uint8_t *)register_content, length, transport_timeout(transport, timeout_ms));
+    }
+    else
+    {
+        uint8_t write_buffer[1 + BNO055_UART_MAX_LENGTH];
+
+        if (slave_handle == NULL)
+            return ESP_ERR_INVALID_ARG;
+
+        // Register address followed by the data, auto-incremented like reads
+        write_buffer[0] = register_address;
+        memcpy(&write_buffer[1], register_content, length);
+        ret = i2c_master_transmit(*slave_handle, write_buffer, 1 + length, transport_timeout(transport, timeout_ms));
+    }
+
+    update_stats(transport, ret, length, start);
+    return ret;
+}
+
+void bno055_transport_reset_stats(bno055_transport_t *transport)
+{
+    if (transport != NULL)
+        memset(&transport->stats, 0, sizeof(bno055_transport_stats_t));
+}
@@ -1,11 +1,18 @@
+#include <math.h>
 #include "helpers_bno055.h"
 
-int signum(double value)
+// Single precision throughout: the ESP32 FPU has no double support, so double math is emulated in software
+
+#define PI_F 3.14159265f
+#define HALF_PI_F 1.57079633f
+#define RAD_TO_DEG_F 57.2957795f
+
+int signum(float value)
 {
     return (value > 0) - (value < 0);
 }
 
-double absolute(double value)
+float absolute(float value)
 {
     if (value < 0)
     {
@@ -14,7 +21,100 @@ double absolute(double value)
     return value;
 }
 
-int quotient(double dividend, double divisor)
+int quotient(float dividend, float divisor)
 {
     return (int)(dividend / divisor);
-}
\ No newline at end of file
+}
+
+float fast_atan2f(float y, float x)
+{
+    float abs_y = absolute(y), abs_x = absolute(x);
+
+    if (abs_x == 0.0f && abs_y == 0.0f)
+        return 0.0f;
+
+    // Reduce to [0, 1] and use an odd minimax polynomial, max error about 1e-5 rad
+    float ratio = (abs_x >= abs_y) ? abs_y / abs_x : abs_x / abs_y;
+    float ratio_2 = ratio * ratio;
+    float angle = ratio * (0.99997726f + ratio_2 * (-0.33262347f + ratio_2 * (0.19354346f + ratio_2 * (-0.11643287f + ratio_2 * (0.05265332f + ratio_2 * -0.01172120f)))));
+
+    if (abs_y > abs_x)
+        angle = HALF_PI_F - angle;
+    if (x < 0.0f)
+        angle = PI_F - angle;
+
+    return (y < 0.0f) ? -angle : angle;
+}
+
+static void normalize(const quaternion_t *quaternion, quaternion_t *unit)
+{
+    // The fixed point output is only approximately normalized
+    float norm = quaternion->w * quaternion->w + quaternion->x * quaternion->x + quaternion->y * quaternion->y + quaternion->z * quaternion->z;
+    float inverse = (norm > 0.0f) ? 1.0f / sqrtf(norm) : 0.0f;
+
+    unit->w = quaternion->w * inverse;
+    unit->x = quaternion->x * inverse;
+    unit->y = quaternion->y * inverse;
+    unit->z = quaternion->z * inverse;
+}
+
+void quaternion_to_euler(const quaternion_t *quaternion, bool radians, bool windows_orientation, vector_t *euler_angles)
+{
+    quaternion_t q;
+    normalize(quaternion, &q);
+
+    // Rotation about z (heading), y (roll) and x (pitch) in the BNO055 register order
+    float yaw = fast_atan2f(2.0f * (q.w * q.z + q.x * q.y), 1.0f - 2.0f * (q.y * q.y + q.z * q.z));
+    float sin_roll = 2.0f * (q.w * q.y - q.z * q.x);
+    if (sin_roll > 1.0f)
+        sin_roll = 1.0f;
+    else if (sin_roll < -1.0f)
+        sin_roll = -1.0f;
+    float roll = fast_atan2f(sin_roll, sqrtf(1.0f - sin_roll * sin_roll));
+    float pitch = fast_atan2f(2.0f * (q.w * q.x + q.y * q.z), 1.0f - 2.0f * (q.x * q.x + q.y * q.y));
+
+    // Heading is 0 to 360 degrees and increases clockwise
+    float heading = 0.0f - yaw;
+    if (heading < 0.0f)
+        heading += 2.0f * PI_F;
+
+    // Windows orientation increases pitch clockwise, Android decreases it
+    if (windows_orientation)
+        pitch = -pitch;
+
+    float scale = radians ? 1.0f : RAD_TO_DEG_F;
+    euler_angles->x = heading * scale;
+    euler_angles->y = roll * scale;
+    euler_angles->z = pitch * scale;
+}
+
+void quaternion_to_gravity(const quaternion_t *quaternion, float magnitude, vector_t *gravity)
+{
+    quaternion_t q;
+    normalize(quaternion, &q);
+
+    // World z axis expressed in the sensor frame, the third row of the rotation matrix
+    gravity->x = 2.0f * (q.x * q.z - q.w * q.y) * magnitude;
+    gravity->y = 2.0f * (q.w * q.x + q.y * q.z) * magnitude;
+    gravity->z = (q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z) * magnitude;
+}
+
+void quaternion_to_rotation_matrix(const quaternion_t *quaternion, rotation_matrix_t *rotation_matrix)
+{
+    quaternion_t q;
+    normalize(quaternion, &q);
+
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    rotation_matrix->m[0][0] = 1.0f - 2.0f * (yy + zz);
+    rotation_matrix->m[0][1] = 2.0f * (xy - wz);
+    rotation_matrix->m[0][2] = 2.0f * (xz + wy);
+    rotation_matrix->m[1][0] = 2.0f * (xy + wz);
+    rotation_matrix->m[1][1] = 1.0f - 2.0f * (xx + zz);
+    rotation_matrix->m[1][2] = 2.0f * (yz - wx);
+    rotation_matrix->m[2][0] = 2.0f * (xz - wy);
+    rotation_matrix->m[2][1] = 2.0f * (yz + wx);
+    rotation_matrix->m[2][2] = 1.0f - 2.0f * (xx + yy);
+}